@@ -0,0 +1,399 @@
+#include "Generators.h"
+#include "VectorKernels.h"
+
+#include "../Source/EventQueue.h"
+#include "../Source/Loader.h"
+#include "../Source/MatchingSolver.h"
+#include "../Source/Pool.h"
+#include "../Source/Pricing.h"
+#include "../Source/SlackKernel.h"
+#include "../Source/Statistics.h"
+#include "../Source/ThreadPool.h"
+#include "../Source/Types.h"
+#include "../Source/Utility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Options shared by both suites.
+struct BenchmarkOptions
+{
+	bool isKernelSuiteEnabled;
+	bool isSolverSuiteEnabled;
+	std::vector<GraphClass> graphClasses;
+	std::vector<int> vertexCounts;
+	unsigned int seed;
+	long long maxEdgeCount;
+	int threadCount;
+	// Solves on this many lightest edges of each vertex first if positive, see solveWithPricing.
+	int candidateCount;
+	// Prints one JSON object per line instead of a table.
+	bool isJsonOutput;
+};
+
+// Graph whose flowers have random types and powers, as seen in the middle of a run.
+struct ScanGraph
+{
+	Pool<Flower> flowerPool;
+	IndexedPool<Edge> edgePool;
+	std::vector<Flower *> flowers;
+};
+
+void generateScanGraph(ScanGraph &graph, int vertexCount, long long edgeCount, unsigned int seed)
+{
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> vertexDistribution(0, vertexCount - 1);
+	std::uniform_int_distribution<int> typeDistribution(0, 3);
+	std::uniform_int_distribution<int> weightDistribution(100, 10000);
+	std::uniform_int_distribution<int> powerDistribution(0, 40);
+
+	graph.flowerPool.reserve(vertexCount);
+	for (int i(0); i < vertexCount; ++i) {
+		Flower *flower(graph.flowerPool.create());
+		flower->vertexId = i + 1;
+		switch (typeDistribution(generator)) {
+		case 0:
+			flower->type = Flower::Type::ODD_IN_TREE;
+			break;
+		case 1:
+			flower->type = Flower::Type::IN_DUMBBELL;
+			break;
+		default:
+			flower->type = Flower::Type::EVEN_IN_TREE;
+			break;
+		}
+		flower->setPower(powerDistribution(generator), 0);
+		graph.flowers.push_back(flower);
+	}
+
+	for (long long i(0); i < edgeCount; ++i) {
+		Edge *edge(graph.edgePool.create());
+		for (int j(0); j < VERTEX_PER_EDGE_COUNT; ++j) {
+			edge->blueFlowerIndices[j] = vertexDistribution(generator);
+		}
+		edge->weight = weightDistribution(generator);
+		if ((i % 16) == 0) {
+			edge->type = Edge::Type::FULL_BLOCKING;
+		}
+	}
+}
+
+// The per-edge loop that findMinEdgeEpsilon ran before edges were queued.
+Weight findMinEdgeEpsilonByLoop(Edge *&minEdge, const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers)
+{
+	Weight minEpsilon(std::numeric_limits<Weight>::max());
+
+	for (int i(0), count(edges.size()); i < count; ++i) {
+		Edge *edge(edges.at(i));
+
+		if (!edge->isFull()) {
+			int incrementableFlowerCount(0);
+			Weight weightPadding(edge->weight - edge->crossedPower(flowers, 0, incrementableFlowerCount));
+
+			if (incrementableFlowerCount > 0) {
+				Weight maxEpsilon(weightPadding / incrementableFlowerCount);
+				if (minEpsilon > maxEpsilon) {
+					minEpsilon = maxEpsilon;
+					minEdge = edge;
+				}
+			}
+		}
+	}
+
+	return minEpsilon;
+}
+
+// Runs the measured function repeatedly and returns the mean time of one run in microseconds.
+template <typename Function>
+double measureMicroseconds(int repetitionCount, Function function)
+{
+	std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+	for (int i(0); i < repetitionCount; ++i) {
+		function();
+	}
+	std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+	return std::chrono::duration<double, std::micro>(end - start).count() / repetitionCount;
+}
+
+int runKernelBenchmark(const BenchmarkOptions &options)
+{
+	const int REPETITION_COUNT(20);
+
+	ThreadPool threadPool(options.threadCount);
+
+	if (!options.isJsonOutput) {
+		std::cout << "Slack kernel: " << vectorKernelName() << ", threads: " << threadPool.threadCount() << std::endl;
+		std::cout << std::left << std::setw(10) << "vertices" << std::setw(10) << "edges"
+			<< std::setw(14) << "loop [us]" << std::setw(14) << "gather [us]" << std::setw(14) << "threads [us]"
+			<< std::setw(14) << "scalar [us]" << std::setw(14) << "kernel [us]" << "match" << std::endl;
+	}
+
+	bool isMatching(true);
+	STD_VECTOR_CONST_FOREACH_(int, options.vertexCounts, vertexCountIt, vertexCountEnd) {
+		int vertexCount(*vertexCountIt);
+		long long edgeCount(std::min(static_cast<long long>(vertexCount) * (vertexCount - 1) / 2, options.maxEdgeCount));
+
+		ScanGraph graph;
+		generateScanGraph(graph, vertexCount, edgeCount, options.seed + static_cast<unsigned int>(vertexCount));
+		EventQueue eventQueue;
+
+		Edge *loopMinEdge(nullptr);
+		Weight loopMinEpsilon(0);
+		double loopTime(measureMicroseconds(REPETITION_COUNT, [&]() {
+			loopMinEpsilon = findMinEdgeEpsilonByLoop(loopMinEdge, graph.edgePool, graph.flowers);
+		}));
+
+		// The full scan gathers the paddings into dense arrays and then runs the kernel.
+		Edge *scanMinEdge(nullptr);
+		Weight scanMinEpsilon(0);
+		double gatherTime(measureMicroseconds(REPETITION_COUNT, [&]() {
+			scanMinEpsilon = eventQueue.scanMinEdgeEpsilon(graph.edgePool, graph.flowers, scanMinEdge);
+		}));
+
+		// The same scan split between the threads of the pool must find the same edge.
+		EventQueue parallelEventQueue;
+		parallelEventQueue.setThreadPool(&threadPool);
+		Edge *parallelMinEdge(nullptr);
+		Weight parallelMinEpsilon(0);
+		double parallelTime(measureMicroseconds(REPETITION_COUNT, [&]() {
+			parallelMinEpsilon = parallelEventQueue.scanMinEdgeEpsilon(graph.edgePool, graph.flowers, parallelMinEdge);
+		}));
+
+		// Measure the kernels alone on the dense arrays.
+		SlackTable slackTable;
+		for (int i(0), count(graph.edgePool.size()); i < count; ++i) {
+			const Edge *edge(graph.edgePool.at(i));
+			Weight weightPadding(edge->weight);
+			int incrementableFlowerCount(0);
+			if (!edge->isFull()) {
+				weightPadding -= edge->crossedPower(graph.flowers, 0, incrementableFlowerCount);
+			}
+			slackTable.push(weightPadding, incrementableFlowerCount);
+		}
+
+		int scalarMinIndex(-1);
+		Weight scalarMinEpsilon(0);
+		double scalarTime(measureMicroseconds(REPETITION_COUNT, [&]() {
+			scalarMinIndex = findMinEpsilonIndex(slackTable, scalarMinEpsilon);
+		}));
+
+		int kernelMinIndex(-1);
+		Weight kernelMinEpsilon(0);
+		double kernelTime(measureMicroseconds(REPETITION_COUNT, [&]() {
+			kernelMinIndex = findMinEpsilonIndexVector(slackTable, kernelMinEpsilon);
+		}));
+
+		bool isRowMatching((loopMinEdge == scanMinEdge) && (loopMinEpsilon == scanMinEpsilon)
+			&& (parallelMinEdge == scanMinEdge) && (parallelMinEpsilon == scanMinEpsilon)
+			&& (scalarMinIndex == kernelMinIndex) && (scalarMinEpsilon == kernelMinEpsilon));
+		isMatching = isMatching && isRowMatching;
+
+		if (options.isJsonOutput) {
+			std::cout << std::fixed << std::setprecision(3)
+				<< "{\"suite\":\"kernels\",\"kernel\":\"" << vectorKernelName() << "\""
+				<< ",\"threads\":" << threadPool.threadCount()
+				<< ",\"vertices\":" << vertexCount << ",\"edges\":" << edgeCount
+				<< ",\"loopMicroseconds\":" << loopTime << ",\"gatherMicroseconds\":" << gatherTime
+				<< ",\"threadsMicroseconds\":" << parallelTime << ",\"scalarMicroseconds\":" << scalarTime
+				<< ",\"kernelMicroseconds\":" << kernelTime
+				<< ",\"match\":" << (isRowMatching ? "true" : "false") << "}" << std::endl;
+		} else {
+			std::cout << std::fixed << std::setprecision(1)
+				<< std::setw(10) << vertexCount << std::setw(10) << edgeCount
+				<< std::setw(14) << loopTime << std::setw(14) << gatherTime << std::setw(14) << parallelTime
+				<< std::setw(14) << scalarTime << std::setw(14) << kernelTime
+				<< (isRowMatching ? "yes" : "NO") << std::endl;
+		}
+	}
+
+	return isMatching ? 0 : 1;
+}
+
+int runSolverBenchmark(const BenchmarkOptions &options)
+{
+	MatchingSolver solver;
+	solver.setThreadCount(options.threadCount);
+	solver.setStatisticsEnabled(true);
+
+	if (!options.isJsonOutput) {
+		std::cout << "Solver, threads: " << options.threadCount << ", seed: " << options.seed << std::endl;
+		std::cout << std::left << std::setw(12) << "class" << std::setw(10) << "vertices" << std::setw(10) << "edges"
+			<< std::setw(14) << "weight" << std::setw(12) << "iterations" << std::setw(12) << "wall [s]" << std::endl;
+	}
+
+	bool isPerfect(true);
+	STD_VECTOR_CONST_FOREACH_(GraphClass, options.graphClasses, graphClassIt, graphClassEnd) {
+		STD_VECTOR_CONST_FOREACH_(int, options.vertexCounts, vertexCountIt, vertexCountEnd) {
+			int vertexCount(*vertexCountIt);
+
+			// Each instance has its own seed, so that it does not depend on the other instances of the run.
+			unsigned int seed(options.seed + static_cast<unsigned int>(vertexCount));
+			InputGraph graph;
+			generateGraph(*graphClassIt, vertexCount, seed, options.maxEdgeCount, options.candidateCount > 0, graph);
+			long long edgeCount(graph.isImplicit() ? static_cast<long long>(vertexCount) * (vertexCount - 1) / 2
+				: static_cast<long long>(graph.edges.size()));
+
+			// With pricing the time includes the selection of the candidate edges and all rounds.
+			const char *errorMessage(nullptr);
+			bool isRowPerfect(false);
+			PricingStatistics pricingStatistics;
+			std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+			if (options.candidateCount > 0) {
+				solveWithPricing(std::move(graph), options.candidateCount, solver, isRowPerfect, pricingStatistics, errorMessage);
+			} else {
+				solver.setGraph(std::move(graph), errorMessage);
+				isRowPerfect = solver.solve();
+			}
+			std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+			double wallSeconds(std::chrono::duration<double>(end - start).count());
+			isPerfect = isPerfect && isRowPerfect;
+
+			const SolverStatistics &statistics(solver.statistics());
+			if (options.isJsonOutput) {
+				std::cout << std::fixed << std::setprecision(6)
+					<< "{\"suite\":\"solver\",\"class\":\"" << graphClassName(*graphClassIt) << "\""
+					<< ",\"vertices\":" << vertexCount << ",\"edges\":" << edgeCount << ",\"seed\":" << seed
+					<< ",\"threads\":" << options.threadCount
+					<< ",\"perfect\":" << (isRowPerfect ? "true" : "false")
+					<< ",\"weight\":" << std::setprecision(0) << solver.pairingWeight() << std::setprecision(6)
+					<< ",\"wallSeconds\":" << wallSeconds;
+				if (options.candidateCount > 0) {
+					std::cout << ",\"pricing\":{\"candidates\":" << options.candidateCount
+						<< ",\"rounds\":" << pricingStatistics.roundCount
+						<< ",\"candidateEdges\":" << pricingStatistics.candidateEdgeCount
+						<< ",\"addedEdges\":" << pricingStatistics.addedEdgeCount
+						<< ",\"pricedEdges\":" << pricingStatistics.pricedEdgeCount << "}";
+				}
+				std::cout << ",\"statistics\":";
+				statistics.writeJson(std::cout);
+				std::cout << "}" << std::endl;
+			} else {
+				std::cout << std::fixed << std::setw(12) << graphClassName(*graphClassIt) << std::setw(10) << vertexCount
+					<< std::setw(10) << edgeCount << std::setw(14) << std::setprecision(0) << solver.pairingWeight()
+					<< std::setw(12) << statistics.iterationCount << std::setw(12) << std::setprecision(3) << wallSeconds
+					<< (isRowPerfect ? "" : "not perfect") << std::endl;
+				std::cout << "    bytes per edge: " << std::setprecision(1) << statistics.bytesPerEdge() << std::endl;
+				if (options.candidateCount > 0) {
+					std::cout << "    pricing rounds: " << pricingStatistics.roundCount
+						<< ", candidate edges: " << pricingStatistics.candidateEdgeCount
+						<< ", added edges: " << pricingStatistics.addedEdgeCount << std::endl;
+				}
+				for (int i(0); i < PHASE_COUNT; ++i) {
+					const PhaseStatistics &phaseStatistics(statistics.phase(static_cast<Phase>(i)));
+					if (phaseStatistics.callCount > 0) {
+						std::cout << "    " << std::setw(30) << phaseName(static_cast<Phase>(i))
+							<< std::setw(12) << phaseStatistics.callCount
+							<< std::setw(12) << std::setprecision(3) << phaseStatistics.seconds << std::endl;
+					}
+				}
+			}
+		}
+	}
+
+	return isPerfect ? 0 : 1;
+}
+
+// Parses a comma separated list of values.
+template <typename Value, typename Parse>
+bool parseList(const char *text, std::vector<Value> &values, Parse parse)
+{
+	values.clear();
+	std::stringstream stream(text);
+	std::string item;
+	while (std::getline(stream, item, ',')) {
+		Value value;
+		if (!parse(item, value)) {
+			return false;
+		}
+		values.push_back(value);
+	}
+	return !values.empty();
+}
+
+void printUsage()
+{
+	std::cerr << "Usage: EdmondsAlgorithmBenchmark [--suite kernels|solver|all] [--classes sparse,euclidean,clustered]" << std::endl
+		<< "    [--sizes 1000,10000,20000] [--seed SEED] [--max-edges COUNT] [--threads COUNT] [--pricing COUNT] [--json]" << std::endl
+		<< "The kernel suite measures the full edge scans, the solver suite solves generated graphs." << std::endl
+		<< "Geometric graphs with more edges than --max-edges only connect the nearest neighbours." << std::endl
+		<< "With --pricing the solver suite starts from the COUNT lightest edges of each vertex." << std::endl
+		<< "Geometric graphs are then complete and only their points are stored." << std::endl
+		<< "With --json each result is printed as one JSON object per line." << std::endl;
+}
+
+int main(const int argc, const char *argv[])
+{
+	// Vertex counts of the instances listed in results.txt.
+	BenchmarkOptions options;
+	options.isKernelSuiteEnabled = true;
+	options.isSolverSuiteEnabled = true;
+	for (int i(0); i < GRAPH_CLASS_COUNT; ++i) {
+		options.graphClasses.push_back(static_cast<GraphClass>(i));
+	}
+	options.vertexCounts = { 1000, 10000, 20000 };
+	options.seed = 1;
+	options.maxEdgeCount = 2000000;
+	options.threadCount = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+	options.candidateCount = 0;
+	options.isJsonOutput = false;
+
+	for (int i(1); i < argc; ++i) {
+		std::string argument(argv[i]);
+		bool isValid(true);
+		if ((argument == "--suite") && (i + 1 < argc)) {
+			std::string suite(argv[++i]);
+			options.isKernelSuiteEnabled = (suite == "kernels") || (suite == "all");
+			options.isSolverSuiteEnabled = (suite == "solver") || (suite == "all");
+			isValid = options.isKernelSuiteEnabled || options.isSolverSuiteEnabled;
+		} else if ((argument == "--classes") && (i + 1 < argc)) {
+			isValid = parseList(argv[++i], options.graphClasses, [](const std::string &item, GraphClass &graphClass) {
+				return parseGraphClass(item.c_str(), graphClass);
+			});
+		} else if ((argument == "--sizes") && (i + 1 < argc)) {
+			isValid = parseList(argv[++i], options.vertexCounts, [](const std::string &item, int &vertexCount) {
+				// Odd vertex counts have no perfect pairing.
+				vertexCount = std::atoi(item.c_str());
+				return (vertexCount >= 2) && ((vertexCount % 2) == 0);
+			});
+		} else if ((argument == "--seed") && (i + 1 < argc)) {
+			options.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+		} else if ((argument == "--max-edges") && (i + 1 < argc)) {
+			options.maxEdgeCount = std::atoll(argv[++i]);
+			isValid = options.maxEdgeCount > 0;
+		} else if ((argument == "--threads") && (i + 1 < argc)) {
+			options.threadCount = std::atoi(argv[++i]);
+			isValid = options.threadCount >= 1;
+		} else if ((argument == "--pricing") && (i + 1 < argc)) {
+			options.candidateCount = std::atoi(argv[++i]);
+			isValid = options.candidateCount >= 1;
+		} else if (argument == "--json") {
+			options.isJsonOutput = true;
+		} else {
+			isValid = false;
+		}
+
+		if (!isValid) {
+			printUsage();
+			return 1;
+		}
+	}
+
+	int result(0);
+	if (options.isKernelSuiteEnabled) {
+		result |= runKernelBenchmark(options);
+	}
+	if (options.isSolverSuiteEnabled) {
+		result |= runSolverBenchmark(options);
+	}
+	return result;
+}
\ No newline at end of file
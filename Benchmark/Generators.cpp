@@ -0,0 +1,209 @@
+#include "Generators.h"
+
+#include "../Source/Loader.h"
+#include "../Source/Utility.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Average number of edges at a vertex of a random sparse graph.
+#define SPARSE_DEGREE 8
+
+// Side of the square that contains all points.
+#define PLANE_SIDE 1000000.0
+
+// Average number of points in a cluster.
+#define CLUSTER_SIZE 100
+
+struct Point
+{
+	double x;
+	double y;
+};
+
+void appendEdge(InputGraph &graph, int vertexA, int vertexB, double weight)
+{
+	InputEdge edge;
+	edge.vertexIds[0] = vertexA + 1;
+	edge.vertexIds[1] = vertexB + 1;
+	edge.weight = weight;
+	graph.edges.push_back(edge);
+}
+
+// Rounds the distance to the nearest integer, just as the EUC_2D metric of TSPLIB.
+double computeDistance(const Point &pointA, const Point &pointB)
+{
+	double dx(pointA.x - pointB.x);
+	double dy(pointA.y - pointB.y);
+	return std::floor(std::sqrt(dx * dx + dy * dy) + 0.5);
+}
+
+void generateRandomSparse(int vertexCount, std::mt19937 &generator, InputGraph &graph)
+{
+	std::uniform_int_distribution<int> vertexDistribution(0, vertexCount - 1);
+	std::uniform_int_distribution<int> weightDistribution(1, 10000);
+
+	std::vector<int> cycle(vertexCount);
+	std::iota(cycle.begin(), cycle.end(), 0);
+	std::shuffle(cycle.begin(), cycle.end(), generator);
+	for (int i(0); i < vertexCount; ++i) {
+		appendEdge(graph, cycle[i], cycle[(i + 1) % vertexCount], weightDistribution(generator));
+	}
+
+	for (long long i(vertexCount), count(static_cast<long long>(vertexCount) * SPARSE_DEGREE / 2); i < count; ++i) {
+		int vertexA(vertexDistribution(generator));
+		int vertexB(vertexDistribution(generator));
+		if (vertexA != vertexB) {
+			appendEdge(graph, vertexA, vertexB, weightDistribution(generator));
+		}
+	}
+}
+
+void generateUniformPoints(int vertexCount, std::mt19937 &generator, std::vector<Point> &points)
+{
+	std::uniform_real_distribution<double> coordinateDistribution(0, PLANE_SIDE);
+	points.resize(vertexCount);
+	STD_VECTOR_FOREACH_(Point, points, pointIt, pointEnd) {
+		pointIt->x = coordinateDistribution(generator);
+		pointIt->y = coordinateDistribution(generator);
+	}
+}
+
+void generateClusteredPoints(int vertexCount, std::mt19937 &generator, std::vector<Point> &points)
+{
+	int clusterCount(std::max(vertexCount / CLUSTER_SIZE, 1));
+	std::vector<Point> centers;
+	generateUniformPoints(clusterCount, generator, centers);
+
+	// The clusters are spread so that they rarely overlap.
+	std::uniform_int_distribution<int> clusterDistribution(0, clusterCount - 1);
+	std::normal_distribution<double> offsetDistribution(0, PLANE_SIDE / std::sqrt(static_cast<double>(clusterCount)) / 8);
+	points.resize(vertexCount);
+	STD_VECTOR_FOREACH_(Point, points, pointIt, pointEnd) {
+		const Point &center(centers[clusterDistribution(generator)]);
+		pointIt->x = center.x + offsetDistribution(generator);
+		pointIt->y = center.y + offsetDistribution(generator);
+	}
+}
+
+void connectPoints(const std::vector<Point> &points, long long maxEdgeCount, InputGraph &graph)
+{
+	int vertexCount(static_cast<int>(points.size()));
+
+	if (static_cast<long long>(vertexCount) * (vertexCount - 1) / 2 <= maxEdgeCount) {
+		for (int i(0); i < vertexCount; ++i) {
+			for (int j(i + 1); j < vertexCount; ++j) {
+				appendEdge(graph, i, j, computeDistance(points[i], points[j]));
+			}
+		}
+		return;
+	}
+
+	// Collect the pairs of nearest neighbours, each in increasing order of its vertices.
+	int neighbourCount(static_cast<int>(std::max(maxEdgeCount / vertexCount, 1LL)));
+	std::vector<std::pair<int, int>> vertexPairs;
+	std::vector<std::pair<double, int>> distances(vertexCount - 1);
+	for (int i(0); i < vertexCount; ++i) {
+		for (int j(0), k(0); j < vertexCount; ++j) {
+			if (j != i) {
+				double dx(points[i].x - points[j].x);
+				double dy(points[i].y - points[j].y);
+				distances[k++] = std::make_pair(dx * dx + dy * dy, j);
+			}
+		}
+		std::nth_element(distances.begin(), distances.begin() + (neighbourCount - 1), distances.end());
+		for (int k(0); k < neighbourCount; ++k) {
+			int j(distances[k].second);
+			vertexPairs.push_back(std::make_pair(std::min(i, j), std::max(i, j)));
+		}
+	}
+
+	// Consecutive points along the x axis form a path through all vertices.
+	std::vector<int> order(vertexCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&](int vertexA, int vertexB) {
+		return points[vertexA].x < points[vertexB].x;
+	});
+	for (int i(0); i + 1 < vertexCount; ++i) {
+		vertexPairs.push_back(std::make_pair(std::min(order[i], order[i + 1]), std::max(order[i], order[i + 1])));
+	}
+
+	std::sort(vertexPairs.begin(), vertexPairs.end());
+	vertexPairs.erase(std::unique(vertexPairs.begin(), vertexPairs.end()), vertexPairs.end());
+	for (std::vector<std::pair<int, int>>::const_iterator pairIt(vertexPairs.cbegin()), pairEnd(vertexPairs.cend());
+		pairIt != pairEnd; ++pairIt) {
+		appendEdge(graph, pairIt->first, pairIt->second, computeDistance(points[pairIt->first], points[pairIt->second]));
+	}
+}
+
+// Keeps the points as the coordinates of an implicit complete graph with the same distances.
+void storePoints(const std::vector<Point> &points, InputGraph &graph)
+{
+	graph.metric = CoordinateMetric::EUC_2D;
+	graph.coordinates.resize(2 * points.size());
+	for (int i(0), count(static_cast<int>(points.size())); i < count; ++i) {
+		graph.coordinates[2 * i] = points[i].x;
+		graph.coordinates[2 * i + 1] = points[i].y;
+	}
+}
+
+bool parseGraphClass(const char *name, GraphClass &graphClass)
+{
+	for (int i(0); i < GRAPH_CLASS_COUNT; ++i) {
+		if (std::strcmp(name, graphClassName(static_cast<GraphClass>(i))) == 0) {
+			graphClass = static_cast<GraphClass>(i);
+			return true;
+		}
+	}
+	return false;
+}
+
+const char *graphClassName(GraphClass graphClass)
+{
+	switch (graphClass) {
+	case GraphClass::RANDOM_SPARSE:
+		return "sparse";
+	case GraphClass::COMPLETE_EUCLIDEAN:
+		return "euclidean";
+	case GraphClass::CLUSTERED:
+		return "clustered";
+	}
+	return "";
+}
+
+void generateGraph(GraphClass graphClass, int vertexCount, unsigned int seed, long long maxEdgeCount,
+	bool isImplicitAllowed, InputGraph &graph)
+{
+	std::mt19937 generator(seed);
+	graph.vertexCount = vertexCount;
+	graph.edges.clear();
+	graph.metric = CoordinateMetric::NONE;
+	graph.coordinates.clear();
+
+	std::vector<Point> points;
+	switch (graphClass) {
+	case GraphClass::RANDOM_SPARSE:
+		generateRandomSparse(vertexCount, generator, graph);
+		break;
+	case GraphClass::COMPLETE_EUCLIDEAN:
+		generateUniformPoints(vertexCount, generator, points);
+		break;
+	case GraphClass::CLUSTERED:
+		generateClusteredPoints(vertexCount, generator, points);
+		break;
+	}
+
+	if (points.empty()) {
+		return;
+	}
+	if (isImplicitAllowed) {
+		storePoints(points, graph);
+	} else {
+		connectPoints(points, maxEdgeCount, graph);
+	}
+}
\ No newline at end of file
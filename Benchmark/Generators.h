@@ -0,0 +1,30 @@
+#ifndef EDMONDS_ALGORITHM_BENCHMARK_GENERATORS_H
+#define EDMONDS_ALGORITHM_BENCHMARK_GENERATORS_H
+
+#include "../Source/Loader.h"
+
+enum class GraphClass : char
+{
+	// A random cycle through all vertices, which keeps a perfect pairing, and random edges of random weights.
+	RANDOM_SPARSE,
+	// Uniformly random points, connected by the rounded Euclidean distances as in TSPLIB.
+	COMPLETE_EUCLIDEAN,
+	// Points spread normally around random centers, as in the clustered TSPLIB-like instances.
+	CLUSTERED
+};
+
+#define GRAPH_CLASS_COUNT 3
+
+// Parses the class name used on the command line.
+bool parseGraphClass(const char *name, GraphClass &graphClass);
+
+const char *graphClassName(GraphClass graphClass);
+
+// Generates a graph of the class with an even vertex count, which is the same for the same seed.
+// Geometric graphs larger than the edge limit only connect each point to its nearest neighbours
+// and to the next point along the x axis, so that a perfect pairing still exists.
+// If isImplicitAllowed is set, geometric graphs are implicit complete graphs regardless of the edge limit.
+void generateGraph(GraphClass graphClass, int vertexCount, unsigned int seed, long long maxEdgeCount,
+	bool isImplicitAllowed, InputGraph &graph);
+
+#endif // EDMONDS_ALGORITHM_BENCHMARK_GENERATORS_H
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "VectorKernels.h"
+
+#include "../Source/Utility.h"
+
+#include <cstring>
+#include <limits>
+
+// The vector kernels work on double weights and are only built for x86 processors.
+#if !defined(ENABLE_INTEGER_WEIGHTS) && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#define ENABLE_SLACK_KERNEL_SIMD
+#endif
+
+#ifdef ENABLE_SLACK_KERNEL_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SLACK_KERNEL_TARGET_AVX2
+#define SLACK_KERNEL_TARGET_AVX512
+#else
+#define SLACK_KERNEL_TARGET_AVX2 __attribute__((target("avx2")))
+#define SLACK_KERNEL_TARGET_AVX512 __attribute__((target("avx512f,avx2")))
+#endif
+#endif
+
+typedef int (*SlackKernel)(const Weight *paddings, const signed char *incrementableCounts, int count,
+	int firstIndex, Weight &minEpsilon, int minIndex);
+
+// Continues the search from the first index with the minimum found so far.
+int scanMinEpsilonIndexScalar(const Weight *paddings, const signed char *incrementableCounts, int count,
+	int firstIndex, Weight &minEpsilon, int minIndex)
+{
+	for (int i(firstIndex); i < count; ++i) {
+		int incrementableCount(incrementableCounts[i]);
+		if (incrementableCount > 0) {
+			Weight epsilon(paddings[i] / incrementableCount);
+			if (epsilon < minEpsilon) {
+				minEpsilon = epsilon;
+				minIndex = i;
+			}
+		}
+	}
+	return minIndex;
+}
+
+#ifdef ENABLE_SLACK_KERNEL_SIMD
+// Combines the per-lane minima, preferring the lowest index among equal epsilon values.
+int reduceLanes(const double *laneEpsilons, const double *laneIndices, int laneCount, Weight &minEpsilon, int minIndex)
+{
+	for (int lane(0); lane < laneCount; ++lane) {
+		int laneIndex(static_cast<int>(laneIndices[lane]));
+		if (laneIndex < 0) {
+			continue;
+		}
+		bool isLess((laneEpsilons[lane] < minEpsilon)
+			|| ((laneEpsilons[lane] == minEpsilon) && ((minIndex < 0) || (laneIndex < minIndex))));
+		if (isLess) {
+			minEpsilon = laneEpsilons[lane];
+			minIndex = laneIndex;
+		}
+	}
+	return minIndex;
+}
+
+SLACK_KERNEL_TARGET_AVX2
+int scanMinEpsilonIndexAvx2(const Weight *paddings, const signed char *incrementableCounts, int count,
+	int firstIndex, Weight &minEpsilon, int minIndex)
+{
+	const __m256d zero(_mm256_setzero_pd());
+	const __m256d laneStep(_mm256_set1_pd(4.0));
+	__m256d minEpsilons(_mm256_set1_pd(minEpsilon));
+	__m256d minIndices(_mm256_set1_pd(-1.0));
+	__m256d indices(_mm256_setr_pd(firstIndex, firstIndex + 1.0, firstIndex + 2.0, firstIndex + 3.0));
+
+	int i(firstIndex);
+	for (; i + 4 <= count; i += 4) {
+		int packedCounts(0);
+		std::memcpy(&packedCounts, incrementableCounts + i, sizeof(packedCounts));
+		__m256d counts(_mm256_cvtepi32_pd(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(packedCounts))));
+
+		// Lanes without incrementable flowers keep the current minimum, so they never win.
+		__m256d isIncrementable(_mm256_cmp_pd(counts, zero, _CMP_GT_OQ));
+		__m256d epsilons(_mm256_blendv_pd(minEpsilons, _mm256_div_pd(_mm256_loadu_pd(paddings + i), counts), isIncrementable));
+
+		__m256d isLess(_mm256_cmp_pd(epsilons, minEpsilons, _CMP_LT_OQ));
+		minEpsilons = _mm256_blendv_pd(minEpsilons, epsilons, isLess);
+		minIndices = _mm256_blendv_pd(minIndices, indices, isLess);
+		indices = _mm256_add_pd(indices, laneStep);
+	}
+
+	double laneEpsilons[4];
+	double laneIndices[4];
+	_mm256_storeu_pd(laneEpsilons, minEpsilons);
+	_mm256_storeu_pd(laneIndices, minIndices);
+	minIndex = reduceLanes(laneEpsilons, laneIndices, 4, minEpsilon, minIndex);
+
+	return scanMinEpsilonIndexScalar(paddings, incrementableCounts, count, i, minEpsilon, minIndex);
+}
+
+SLACK_KERNEL_TARGET_AVX512
+int scanMinEpsilonIndexAvx512(const Weight *paddings, const signed char *incrementableCounts, int count,
+	int firstIndex, Weight &minEpsilon, int minIndex)
+{
+	const __m512d zero(_mm512_setzero_pd());
+	const __m512d laneStep(_mm512_set1_pd(8.0));
+	__m512d minEpsilons(_mm512_set1_pd(minEpsilon));
+	__m512d minIndices(_mm512_set1_pd(-1.0));
+	__m512d indices(_mm512_setr_pd(firstIndex, firstIndex + 1.0, firstIndex + 2.0, firstIndex + 3.0,
+		firstIndex + 4.0, firstIndex + 5.0, firstIndex + 6.0, firstIndex + 7.0));
+
+	int i(firstIndex);
+	for (; i + 8 <= count; i += 8) {
+		// The conversion starts from the zero vector, as the unmasked form would merge into an undefined one.
+		__m512d counts(_mm512_mask_cvtepi32_pd(zero, 0xFF, _mm256_cvtepi8_epi32(
+			_mm_loadl_epi64(reinterpret_cast<const __m128i *>(incrementableCounts + i)))));
+
+		// Lanes without incrementable flowers keep the current minimum, so they never win.
+		__mmask8 isIncrementable(_mm512_cmp_pd_mask(counts, zero, _CMP_GT_OQ));
+		__m512d epsilons(_mm512_mask_div_pd(minEpsilons, isIncrementable, _mm512_loadu_pd(paddings + i), counts));
+
+		__mmask8 isLess(_mm512_cmp_pd_mask(epsilons, minEpsilons, _CMP_LT_OQ));
+		minEpsilons = _mm512_mask_mov_pd(minEpsilons, isLess, epsilons);
+		minIndices = _mm512_mask_mov_pd(minIndices, isLess, indices);
+		indices = _mm512_add_pd(indices, laneStep);
+	}
+
+	double laneEpsilons[8];
+	double laneIndices[8];
+	_mm512_storeu_pd(laneEpsilons, minEpsilons);
+	_mm512_storeu_pd(laneIndices, minIndices);
+	minIndex = reduceLanes(laneEpsilons, laneIndices, 8, minEpsilon, minIndex);
+
+	return scanMinEpsilonIndexScalar(paddings, incrementableCounts, count, i, minEpsilon, minIndex);
+}
+
+#ifdef _MSC_VER
+// Checks the processor feature bits and that the operating system saves the wide registers.
+bool isInstructionSetSupported(bool isAvx512)
+{
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	__cpuid(info, 1);
+	bool hasOsSupport((info[2] & (1 << 27)) != 0);
+	if (!hasOsSupport) {
+		return false;
+	}
+	unsigned long long enabledStates(_xgetbv(0));
+	__cpuidex(info, 7, 0);
+	if (isAvx512) {
+		return ((enabledStates & 0xE6) == 0xE6) && ((info[1] & (1 << 16)) != 0);
+	}
+	return ((enabledStates & 0x6) == 0x6) && ((info[1] & (1 << 5)) != 0);
+}
+#else
+bool isInstructionSetSupported(bool isAvx512)
+{
+	__builtin_cpu_init();
+	return isAvx512 ? (__builtin_cpu_supports("avx512f") != 0) : (__builtin_cpu_supports("avx2") != 0);
+}
+#endif
+#endif
+
+// Kernel chosen for the processor the program runs on.
+struct SlackKernelChoice
+{
+	SlackKernel kernel;
+	const char *name;
+};
+
+SlackKernelChoice selectSlackKernel()
+{
+	SlackKernelChoice choice;
+	choice.kernel = &scanMinEpsilonIndexScalar;
+	choice.name = "scalar";
+#ifdef ENABLE_SLACK_KERNEL_SIMD
+	if (isInstructionSetSupported(true)) {
+		choice.kernel = &scanMinEpsilonIndexAvx512;
+		choice.name = "avx512";
+	} else if (isInstructionSetSupported(false)) {
+		choice.kernel = &scanMinEpsilonIndexAvx2;
+		choice.name = "avx2";
+	}
+#endif
+	return choice;
+}
+
+const SlackKernelChoice &slackKernelChoice()
+{
+	// The processor is inspected only once.
+	static const SlackKernelChoice choice(selectSlackKernel());
+	return choice;
+}
+
+int findMinEpsilonIndexVector(const SlackTable &slackTable, Weight &minEpsilon)
+{
+	minEpsilon = std::numeric_limits<Weight>::max();
+	return slackKernelChoice().kernel(slackTable.paddings.data(), slackTable.incrementableCounts.data(),
+		slackTable.size(), 0, minEpsilon, -1);
+}
+
+const char *vectorKernelName()
+{
+	return slackKernelChoice().name;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#ifndef EDMONDS_ALGORITHM_BENCHMARK_VECTOR_KERNELS_H
+#define EDMONDS_ALGORITHM_BENCHMARK_VECTOR_KERNELS_H
+
+#include "../Source/SlackKernel.h"
+
+// Same as findMinEpsilonIndex, but uses the widest vector instructions supported by the processor.
+// The solver finds its epsilon through the queues, so these kernels are only measured against the plain scan.
+int findMinEpsilonIndexVector(const SlackTable &slackTable, Weight &minEpsilon);
+
+// Names the instruction set chosen by findMinEpsilonIndexVector.
+const char *vectorKernelName();
+
+#endif // EDMONDS_ALGORITHM_BENCHMARK_VECTOR_KERNELS_H
\ No newline at end of file
@@ -1,117 +1,128 @@
 #include "Actions.h"
 
+#include "EventQueue.h"
+#include "Pool.h"
 #include "Types.h"
 #include "Utility.h"
 
 #include <algorithm>
+#include <cstdlib>
+#include <iostream>
 #include <vector>
 
 #if VERTEX_PER_EDGE_COUNT != 2
 CREATE A COMPILATION ERROR
 #endif
 
-// Properly sorts the flowers:
-// The first flower becomes the start flower, then follows an odd number of flowers,
-// then follows the end flower, then follows an even number of flowers.
-void reorderFlowers(std::vector<Flower *> &flowers, int &startFlowerId, int &endFlowerId)
+// Returns the subflower at the position along the cycle walked from the start subflower,
+// forward or backward, without reordering the subflowers of the flower.
+Flower *walkCycle(const std::vector<Flower *> &subFlowers, int startFlowerId, bool isBackward, int position)
 {
-	int flowersCount(static_cast<int>(flowers.size()));
+	int flowersCount(static_cast<int>(subFlowers.size()));
+	int flowerId(isBackward ? startFlowerId - position + flowersCount : startFlowerId + position);
+	return subFlowers[flowerId % flowersCount];
+}
 
-	// Determine the size of the segment of subflowers that would remain in the tree.
-	int segmentSize(endFlowerId - startFlowerId + 1);
-	if (segmentSize < 1) {
-		segmentSize += flowersCount;
-	}
+// Changes the type of the flower and marks its edges for requeueing.
+void setFlowerType(Flower *flower, Flower::Type type, EventQueue &eventQueue)
+{
+	flower->setType(type, eventQueue.dualOffset());
+	eventQueue.touchFlower(flower);
+}
 
-	// If the segment size is even then the segment's complement contains the disired subflowers.
-	if ((segmentSize % 2) == 0) {
-		std::reverse(flowers.begin(), flowers.end());
-		startFlowerId = flowersCount - (startFlowerId + 1);
-		endFlowerId = flowersCount - (endFlowerId + 1);
+#ifdef ENABLE_DEBUG_ASSERTIONS
+// Returns the blocking edge between two disjoint flowers found by a scan of their edges, or null if there is none.
+Edge *findBlockingEdge(Flower *flowerA, Flower *flowerB, const std::vector<Flower *> &flowers)
+{
+	for (Flower *blueFlower(flowerA->firstBlueFlower); blueFlower != nullptr; blueFlower = flowerA->nextBlueFlower(blueFlower)) {
+		RANGE_FOREACH_(EdgeRange, blueFlower->edges, edgeIt, edgeEnd) {
+			Edge *edge(*edgeIt);
+			if ((edge->type == Edge::Type::FULL_BLOCKING) && flowerB->contains(edge->oppositeBlueFlower(blueFlower, flowers))) {
+				return edge;
+			}
+		}
 	}
+	return nullptr;
+}
+#endif
 
-	// If needed the subflower array will be cyclically shifted to begin with the start subflower.
-	if (startFlowerId > 0) {
-		std::vector<Flower *> currentSubFlowers(flowers);
-		for (int i(0); i < flowersCount; ++i) {
-			flowers[i] = currentSubFlowers[(startFlowerId + i) % flowersCount];
-		}
+// Returns the kept full edge between two disjoint flowers, which a scan confirms in debug builds.
+Edge *checkLinkedEdge(Edge *edge, Flower *flowerA, Flower *flowerB, const std::vector<Flower *> &flowers)
+{
+#ifdef ENABLE_DEBUG_ASSERTIONS
+	// ASSERTION: The kept edge joins the flowers and no other blocking edge does.
+	Edge *blockingEdge(findBlockingEdge(flowerA, flowerB, flowers));
+	bool isJoining((edge != nullptr) && edge->isFull()
+		&& ((flowerA->contains(edge->blueFlower(0, flowers)) && flowerB->contains(edge->blueFlower(1, flowers)))
+			|| (flowerA->contains(edge->blueFlower(1, flowers)) && flowerB->contains(edge->blueFlower(0, flowers)))));
+	if (!isJoining || ((blockingEdge != nullptr) && (blockingEdge != edge))) {
+		std::cout << "Assertion failed: The kept edge between two flowers differs from the scanned one." << std::endl;
+		std::exit(-1);
 	}
+#else
+	(void)flowerA;
+	(void)flowerB;
+	(void)flowers;
+#endif
 
-	// Determine new start and end indices.
-	if (startFlowerId > endFlowerId) {
-		endFlowerId += flowersCount - startFlowerId;
-	} else {
-		endFlowerId -= startFlowerId;
-	}	
-	startFlowerId = 0;
+	return edge;
 }
 
-void setBlockingEdgeToRegular(Flower *flowerA, Flower *flowerB)
+void setBlockingEdgeToRegular(Edge *edge, Flower *flowerA, Flower *flowerB, const std::vector<Flower *> &flowers)
 {
-	STD_VECTOR_FOREACH_(Edge *, flowerA->edges, edgeIt, edgeEnd) {
-		Edge *edge(*edgeIt);
-		bool isConnectedToPrevSubFlower((edge->type == Edge::Type::FULL_BLOCKING)
-			&& (std::find(edge->flowers.begin(), edge->flowers.end(), flowerB) != edge->flowers.end()));
-		if (isConnectedToPrevSubFlower) {
-			edge->type = Edge::Type::REGULAR;
-		}
+	Edge *linkedEdge(checkLinkedEdge(edge, flowerA, flowerB, flowers));
+	if (linkedEdge->type == Edge::Type::FULL_BLOCKING) {
+		linkedEdge->type = Edge::Type::REGULAR;
+	}
+}
+
+// Makes every subflower of the green flower a free flower.
+void splitMembership(Flower *greenFlower)
+{
+	// The flowers nested deeper find their new outer flower through the enclosing flowers, so they are left as they are.
+	STD_VECTOR_FOREACH_(Flower *, greenFlower->subFlowers, flowerIt, flowerEnd) {
+		(*flowerIt)->enclosingFlower = nullptr;
 	}
 }
 
-void executeBurstFlower(Flower *greenFlower)
+// Removes the green flower from the queue, after which it can be deleted.
+// No edge refers to the flower, so nothing else has to be detached.
+void detachGreenFlower(Flower *greenFlower, EventQueue &eventQueue)
 {
+	eventQueue.removeFlower(greenFlower);
+}
+
+void executeBurstFlower(Flower *greenFlower, EventQueue &eventQueue)
+{
+	const std::vector<Flower *> &flowers(eventQueue.flowers());
+
 	// Find the subflower that connects to the parent.
 	Flower *upperSubFlower(nullptr);
 	{
 		// Find the edge that connects to the parent.
-		Edge *parentEdge(nullptr);
-		STD_VECTOR_FOREACH_(Edge *, greenFlower->parent->edges, edgeIt, edgeEnd) {
-			Edge *edge(*edgeIt);
+		Edge *parentEdge(checkLinkedEdge(greenFlower->parentEdge, greenFlower->parent, greenFlower, flowers));
 
-			if (edge->type == Edge::Type::FULL_BLOCKING) {
-				const std::vector<Flower *> &edgeFlowers(edge->flowers);
-				if (std::find(edgeFlowers.begin(), edgeFlowers.end(), greenFlower) != edgeFlowers.end()) {
-					parentEdge = edge;
-					break;
-				}
-			}
+		// The edge crosses exactly the subflower containing its blue flower within the green flower.
+		upperSubFlower = greenFlower->subFlowerContaining(parentEdge->blueFlower(0, flowers));
+		if (upperSubFlower == nullptr) {
+			upperSubFlower = greenFlower->subFlowerContaining(parentEdge->blueFlower(1, flowers));
 		}
-		const std::vector<Flower *> &parentEdgeFlowers(parentEdge->flowers);
 
-		// Find the subflower that connects to the edge that connects to the parent.
-		STD_VECTOR_FOREACH_(Flower *, greenFlower->subFlowers, flowerIt, flowerEnd) {
-			upperSubFlower = *flowerIt;
-			if (std::find(parentEdgeFlowers.begin(), parentEdgeFlowers.end(), upperSubFlower) != parentEdgeFlowers.end()) {
-				break;
-			}
-		}
+		// Split the membership of the green flower among its subflowers.
+		splitMembership(greenFlower);
 	}
 
 	// Find the subflower that contains the stem vertex.
 	Flower *lowerSubFlower(greenFlower->stemSubFlower);
 	
-	// Initialize variables for sub flower reordering.
-	std::vector<Flower *> greenFlowerSubFlowers(greenFlower->subFlowers);	
-
-	int upperSubFlowerId(0);
-	int lowerSubFlowerId(0);
-	int subFlowersCount(static_cast<int>(greenFlowerSubFlowers.size()));
-
-	// Find the indices of the upper and lower subflowers.
-	for (int i(0); i < subFlowersCount; ++i) {
-		if (greenFlowerSubFlowers[i] == upperSubFlower) {
-			upperSubFlowerId = i;
-		}
-		if (greenFlowerSubFlowers[i] == lowerSubFlower) {
-			lowerSubFlowerId = i;
-		}
-	}
-	
-	// Reorder green subflowers.
-	// The first flower becomes the upper subflower, then follows an odd number of flowers,
-	// then follows the lower subflower, then follows an even number of flowers.
-	reorderFlowers(greenFlowerSubFlowers, upperSubFlowerId, lowerSubFlowerId);
+	// Walk the cycle from the upper subflower in the direction in which the segment up to the lower subflower
+	// holds an odd number of flowers. The segment remains in the tree, the even number of flowers after it become dumbbells.
+	const std::vector<Flower *> &subFlowers(greenFlower->subFlowers);
+	int subFlowersCount(static_cast<int>(subFlowers.size()));
+	int upperSubFlowerId(upperSubFlower->cycleIndex);
+	int forwardDistance((lowerSubFlower->cycleIndex - upperSubFlowerId + subFlowersCount) % subFlowersCount);
+	bool isBackward((forwardDistance % 2) != 0);
+	int lowerSubFlowerPosition(isBackward ? subFlowersCount - forwardDistance : forwardDistance);
 
 	// Replace the green flower in the connection with its parent by the upper sub flower.
 	{
@@ -124,6 +135,7 @@ void executeBurstFlower(Flower *greenFlower)
 
 		// Set the green flower's parent as the upper sub flower's parent.
 		upperSubFlower->parent = greenFlower->parent;
+		upperSubFlower->parentEdge = greenFlower->parentEdge;
 	}
 
 	// Replace the green flower in the connection with its child by the lower sub flower.
@@ -138,40 +150,42 @@ void executeBurstFlower(Flower *greenFlower)
 	}
 
 	// Process the segment of subflowers that remains in the tree.
-	for (int i(upperSubFlowerId), count(lowerSubFlowerId + 1); i < count; ++i) {
-		Flower *subFlower(greenFlowerSubFlowers[i]);
+	for (int i(0); i <= lowerSubFlowerPosition; ++i) {
+		Flower *subFlower(walkCycle(subFlowers, upperSubFlowerId, isBackward, i));
 
-		subFlower->type = ((i % 2) == 0) ? Flower::Type::ODD_IN_TREE: Flower::Type::EVEN_IN_TREE;		
+		setFlowerType(subFlower, ((i % 2) == 0) ? Flower::Type::ODD_IN_TREE : Flower::Type::EVEN_IN_TREE, eventQueue);
+		subFlower->treeId = greenFlower->treeId;
 		if (subFlower->parent == nullptr) {
-			subFlower->parent = greenFlowerSubFlowers[i - 1];
+			subFlower->parent = walkCycle(subFlowers, upperSubFlowerId, isBackward, i - 1);
+			subFlower->parentEdge = greenFlower->cycleEdge(subFlower->parent, subFlower);
 		}
 		if (subFlower->children.empty()) {
-			subFlower->children.push_back(greenFlowerSubFlowers[i + 1]);
+			subFlower->children.push_back(walkCycle(subFlowers, upperSubFlowerId, isBackward, i + 1));
 		}
 	}
 
 	// Process all subflowers that become Dumbbells.
-	for (int i(lowerSubFlowerId + 1); i < subFlowersCount; ++i) {
-		greenFlowerSubFlowers[i]->type = Flower::Type::IN_DUMBBELL;
+	for (int i(lowerSubFlowerPosition + 1); i < subFlowersCount; ++i) {
+		Flower *subFlower(walkCycle(subFlowers, upperSubFlowerId, isBackward, i));
+		setFlowerType(subFlower, Flower::Type::IN_DUMBBELL, eventQueue);
+		subFlower->treeId = -1;
 	}
 
 	// Set blocking edges at the beginning and end of the tree segments as regular.
-	setBlockingEdgeToRegular(lowerSubFlower, greenFlowerSubFlowers[(lowerSubFlowerId + 1) % subFlowersCount]);
-	for (int i(lowerSubFlowerId + 1), count(subFlowersCount - 1); i < count; ++i) {
-		setBlockingEdgeToRegular(greenFlowerSubFlowers[i], greenFlowerSubFlowers[i + 1]);
+	for (int i(lowerSubFlowerPosition); i < subFlowersCount; ++i) {
+		Flower *flowerA(walkCycle(subFlowers, upperSubFlowerId, isBackward, i));
+		Flower *flowerB(walkCycle(subFlowers, upperSubFlowerId, isBackward, i + 1));
+		setBlockingEdgeToRegular(greenFlower->cycleEdge(flowerA, flowerB), flowerA, flowerB, flowers);
 	}
-	setBlockingEdgeToRegular(upperSubFlower, greenFlowerSubFlowers[subFlowersCount - 1]);
-	
 
-	// Remove the green flower from all edges.
-	STD_VECTOR_FOREACH_(Edge *, greenFlower->edges, edgeIt, edgeEnd) {
-		std::vector<Flower *> &edgeFlowers((*edgeIt)->flowers);
-		edgeFlowers.erase(std::remove(edgeFlowers.begin(), edgeFlowers.end(), greenFlower), edgeFlowers.end());
-	}
+	// Remove the green flower from the queue.
+	detachGreenFlower(greenFlower, eventQueue);
 }
 
-void executeAppendDumbbell(Edge *minEdge, std::vector<Flower *> &freeFlowers)
+void executeAppendDumbbell(Edge *minEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue)
 {
+	const std::vector<Flower *> &flowers(eventQueue.flowers());
+
 	minEdge->type = Edge::Type::FULL_BLOCKING;
 
 	// Determine the tree flower and the upper Dumbbell flower.
@@ -184,10 +198,12 @@ void executeAppendDumbbell(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 	// Set parameters for the upper Dumbbell flower.
 	treeFlower->children.push_back(upperDumbbellFlower);
 	upperDumbbellFlower->parent = treeFlower;
-	upperDumbbellFlower->type = Flower::Type::ODD_IN_TREE;
+	upperDumbbellFlower->parentEdge = minEdge;
+	upperDumbbellFlower->treeId = treeFlower->treeId;
+	setFlowerType(upperDumbbellFlower, Flower::Type::ODD_IN_TREE, eventQueue);
 
 	// Determine the lower Dumbbell flower.
-	std::vector<Flower *> dumbbellFreeFlowers(upperDumbbellFlower->inPairingEdge()->freeFlowers());
+	std::vector<Flower *> dumbbellFreeFlowers(upperDumbbellFlower->inPairingEdge(flowers)->freeFlowers(flowers));
 	Flower *lowerDumbbellFlower(dumbbellFreeFlowers.front());
 	if (lowerDumbbellFlower == upperDumbbellFlower) {
 		lowerDumbbellFlower = dumbbellFreeFlowers.back();
@@ -196,10 +212,13 @@ void executeAppendDumbbell(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 	// Set parameters for the lower Dumbbell flower.
 	upperDumbbellFlower->children.push_back(lowerDumbbellFlower);
 	lowerDumbbellFlower->parent = upperDumbbellFlower;
-	lowerDumbbellFlower->type = Flower::Type::EVEN_IN_TREE;
+	lowerDumbbellFlower->parentEdge = upperDumbbellFlower->pairingEdge;
+	lowerDumbbellFlower->treeId = treeFlower->treeId;
+	setFlowerType(lowerDumbbellFlower, Flower::Type::EVEN_IN_TREE, eventQueue);
 }
 
-Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers)
+Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue,
+	Pool<Flower> &flowerPool)
 {
 	minEdge->type = Edge::Type::FULL_BLOCKING;
 
@@ -227,9 +246,13 @@ Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 	}
 
 	// Create and initialize Z flower, which is the new flower.
-	Flower *zFlower(new Flower());
+	Flower *zFlower(flowerPool.create());
+	zFlower->setPower(0, eventQueue.dualOffset());
 	zFlower->parent = wFlower->parent;
+	zFlower->parentEdge = wFlower->parentEdge;
 	zFlower->stemSubFlower = wFlower;
+	zFlower->pairingEdge = wFlower->pairingEdge;
+	zFlower->treeId = wFlower->treeId;
 
 	// Replace W flower with Z flower in Z flower's parent.
 	if (zFlower->parent != nullptr) {
@@ -243,36 +266,46 @@ Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 	for (; kRIt != kREnd; ++kRIt) {
 		zFlower->subFlowers.push_back(*kRIt);
 	}
+	int kFlowerId(static_cast<int>(zFlower->subFlowers.size()) - 1);
 	for (std::vector<Flower*>::iterator hIt(hPathToRoot.begin()); *hIt != wFlower; ++hIt) {
 		zFlower->subFlowers.push_back(*hIt);
 	}
 
-	// Populate children and edges of Z flower.
-	std::vector<Flower *> zBlueFlowers(zFlower->blueSubFlowers());
+	// Keep the edges of the cycle, which are the parent edges of the subflowers on both paths and the min edge between them.
+	int subFlowersCount(static_cast<int>(zFlower->subFlowers.size()));
+	zFlower->cycleEdges.resize(subFlowersCount);
+	for (int i(0); i < subFlowersCount; ++i) {
+		if (i < kFlowerId) {
+			zFlower->cycleEdges[i] = zFlower->subFlowers[i + 1]->parentEdge;
+		} else if (i == kFlowerId) {
+			zFlower->cycleEdges[i] = minEdge;
+		} else {
+			zFlower->cycleEdges[i] = zFlower->subFlowers[i]->parentEdge;
+		}
+		zFlower->subFlowers[i]->cycleIndex = i;
+		zFlower->subFlowers[i]->enclosingFlower = zFlower;
+		zFlower->nestingHeight = std::max(zFlower->nestingHeight, zFlower->subFlowers[i]->nestingHeight + 1);
+	}
+
+	// Populate children of Z flower and link the runs of blue flowers of its subflowers in cycle order.
+	// The edges of Z flower are not copied, as they are found through its blue flowers.
+	zFlower->firstBlueFlower = zFlower->subFlowers.front()->firstBlueFlower;
+	zFlower->lastBlueFlower = zFlower->subFlowers.back()->lastBlueFlower;
+	Flower *previousSubFlower(nullptr);
 	STD_VECTOR_FOREACH_(Flower *, zFlower->subFlowers, subFlowerIt, subFlowerEnd) {
 		Flower *subFlower(*subFlowerIt);
+		if (previousSubFlower != nullptr) {
+			previousSubFlower->lastBlueFlower->followingBlueFlower = subFlower->firstBlueFlower;
+		}
+		previousSubFlower = subFlower;
 		
 		// Add the children of subflowers into Z flower's children only if the child is not part of Z flower.
 		STD_VECTOR_FOREACH_(Flower *, subFlower->children, childFlowerIt, childFlowerEnd) {
 			Flower *childFlower(*childFlowerIt);
-			if (std::find(zBlueFlowers.begin(), zBlueFlowers.end(), childFlower->blueStem()) == zBlueFlowers.end()) {
+			if (childFlower->enclosingFlower != zFlower) {
 				zFlower->children.push_back(childFlower);
 			}
 		}
-		
-		// Add the edges of subflowers into Z flower's edges only if the edge is outgoing from Z flower.
-		STD_VECTOR_FOREACH_(Edge *, subFlower->edges, subEdgeIt, subEdgeEnd) {
-			Edge *subEdge(*subEdgeIt);			
-			
-			bool areBothEdgeBlueFlowersInZFlower(
-				std::find(zBlueFlowers.begin(), zBlueFlowers.end(), subEdge->blueFlowers.front()) != zBlueFlowers.end()
-				&& std::find(zBlueFlowers.begin(), zBlueFlowers.end(), subEdge->blueFlowers.back()) != zBlueFlowers.end());
-
-			if (!areBothEdgeBlueFlowersInZFlower) {
-				zFlower->edges.push_back(subEdge);
-				subEdge->flowers.push_back(zFlower);
-			}
-		}
 	}
 
 	// Replace parent in the new children of Z Flower.
@@ -284,102 +317,94 @@ Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 	// Set subflower parameters.
 	STD_VECTOR_FOREACH_(Flower *, zFlower->subFlowers, flowerIt, flowerEnd) {
 		Flower *subflower(*flowerIt);
-		subflower->type = Flower::Type::INTERNAL;
+		setFlowerType(subflower, Flower::Type::INTERNAL, eventQueue);
 		subflower->parent = nullptr;
+		subflower->parentEdge = nullptr;
 		subflower->children.clear();
 	}
 
 	return zFlower;
 }
 
-std::vector<Edge *> preprocessAlternatingPathEdges(Flower *flower, Edge *outgoingEdge)
+// Collects the edges of the alternating path from the stem of the flower to the edge by which the path leaves it,
+// and makes the subflowers left by the path the new stems.
+// The nested cycles are walked from an explicit stack in place, so the work is linear in the number of path edges.
+void preprocessAlternatingPathEdges(Flower *flower, Edge *outgoingEdge, const std::vector<Flower *> &flowers,
+	AlternatingPathBuffers &pathBuffers)
 {
-	std::vector<Edge *> pathEdges;
+	std::vector<std::pair<Flower *, Edge *>> &pendingFlowers(pathBuffers.pendingFlowers);
+	pendingFlowers.clear();
+	pendingFlowers.emplace_back(flower, outgoingEdge);
 
-	if (!flower->subFlowers.empty()) {
-		std::vector<Flower *> subFlowers(flower->subFlowers);
+	while (!pendingFlowers.empty()) {
+		Flower *currentFlower(pendingFlowers.back().first);
+		Edge *currentOutgoingEdge(pendingFlowers.back().second);
+		pendingFlowers.pop_back();
 
-		// Find outgoing sub flower.
-		Flower *outgoingSubFlower(nullptr);
-		STD_VECTOR_FOREACH_(Flower *, subFlowers, flowerIt, flowerEnd) {
-			Flower *subFlower(*flowerIt);
-			if (std::find(subFlower->edges.begin(), subFlower->edges.end(), outgoingEdge) != subFlower->edges.end()) {
-				outgoingSubFlower = subFlower;
-				break;
-			}
+		// The outgoing edge becomes the in pairing edge of the flower once the types are swapped.
+		currentFlower->pairingEdge = currentOutgoingEdge;
+
+		const std::vector<Flower *> &subFlowers(currentFlower->subFlowers);
+		if (subFlowers.empty()) {
+			continue;
 		}
-		
-		// Initialize variables for sub flower reordering.
-		int stemSubFlowerId(0);
-		int outgoingSubFlowerId(0);
-		int subFlowersCount(static_cast<int>(subFlowers.size()));
 
-		// Find the indices of the stem and outgoing subflowers.
-		for (int i(0); i < subFlowersCount; ++i) {
-			if (subFlowers[i] == flower->stemSubFlower) {
-				stemSubFlowerId = i;
-			}
-			if (subFlowers[i] == outgoingSubFlower) {
-				outgoingSubFlowerId = i;
-			}
+		// Find the stem and outgoing subflowers.
+		// The outgoing edge crosses exactly the subflower containing its inner end.
+		Flower *outgoingSubFlower(currentFlower->subFlowerContaining(currentOutgoingEdge->blueFlower(0, flowers)));
+		if (outgoingSubFlower == nullptr) {
+			outgoingSubFlower = currentFlower->subFlowerContaining(currentOutgoingEdge->blueFlower(1, flowers));
 		}
+		int stemSubFlowerId(currentFlower->stemSubFlower->cycleIndex);
+		int outgoingSubFlowerId(outgoingSubFlower->cycleIndex);
+		int subFlowersCount(static_cast<int>(subFlowers.size()));
 
-		// Reorder subflowers.
-		// The first flower becomes the stem subflower, then follows an odd number of flowers,
-		// then follows the outgoing subflower, then follows an even number of flowers.
-		reorderFlowers(subFlowers, stemSubFlowerId, outgoingSubFlowerId);
+		// Walk the cycle from the stem subflower in the direction in which an odd number of flowers
+		// precedes the outgoing subflower, just as executeBurstFlower walks from its upper subflower.
+		int forwardDistance((outgoingSubFlowerId - stemSubFlowerId + subFlowersCount) % subFlowersCount);
+		int step(((forwardDistance % 2) == 0) ? 1 : subFlowersCount - 1);
+		int pathLength(((forwardDistance % 2) == 0) ? forwardDistance : subFlowersCount - forwardDistance);
 
-		for (int i(0); i < outgoingSubFlowerId; i += 2) {
-			Flower *flowerA(subFlowers[i]);
-			Flower *flowerB(subFlowers[i + 1]);
+		int subFlowerIdA(stemSubFlowerId);
+		for (int i(0); i < pathLength; i += 2) {
+			int subFlowerIdB((subFlowerIdA + step) % subFlowersCount);
+			Flower *flowerA(subFlowers[subFlowerIdA]);
+			Flower *flowerB(subFlowers[subFlowerIdB]);
 
 			// Find outgoing sub edge.
-			Edge *outgoingSubEdge(nullptr);
-			STD_VECTOR_FOREACH_(Edge *, flowerA->edges, edgeIt, edgeEnd) {
-				Edge *edge(*edgeIt);
-				if (edge->type == Edge::Type::FULL_BLOCKING) {
-					if (std::find(edge->flowers.begin(), edge->flowers.end(), flowerB) != edge->flowers.end()) {
-						outgoingSubEdge = edge;
-						break;
-					}
-				}
-			}
+			Edge *outgoingSubEdge(checkLinkedEdge(currentFlower->cycleEdge(flowerA, flowerB), flowerA, flowerB, flowers));
 
-			// Append edges within flower A.
-			std::vector<Edge *> subPathEdgesA(preprocessAlternatingPathEdges(flowerA, outgoingSubEdge));
-			pathEdges.insert(pathEdges.end(), subPathEdgesA.begin(), subPathEdgesA.end());
+			// The pairing edge must be taken before the stem of flower B is moved by its own path.
+			// Flower B is not the stem subflower, so its only in pairing edge is outgoing.
+			pathBuffers.pathEdges.push_back(outgoingSubEdge);
+			pathBuffers.pathEdges.push_back(flowerB->inPairingEdge(flowers));
 
-			// Append edge between flower A and B.
-			pathEdges.push_back(outgoingSubEdge);
+			// The paths within flowers A and B end at the edge between them.
+			pendingFlowers.emplace_back(flowerA, outgoingSubEdge);
+			pendingFlowers.emplace_back(flowerB, outgoingSubEdge);
 
-			// Append edges within flower B.
-			std::vector<Edge *> subPathEdgesB(preprocessAlternatingPathEdges(flowerB, outgoingSubEdge));
-			pathEdges.insert(pathEdges.end(), subPathEdgesB.begin(), subPathEdgesB.end());
-
-			// Append pairing edge outgoing from flower B.
-			pathEdges.push_back(flowerB->blueStem()->inPairingEdge());
+			subFlowerIdA = (subFlowerIdB + step) % subFlowersCount;
 		}
 
-		// Append edges within the last flower.
-		std::vector<Edge *> lastSubPathEdges(preprocessAlternatingPathEdges(subFlowers[outgoingSubFlowerId], outgoingEdge));
-		pathEdges.insert(pathEdges.end(), lastSubPathEdges.begin(), lastSubPathEdges.end());
-		
+		// The path within the last flower ends at the outgoing edge.
+		pendingFlowers.emplace_back(outgoingSubFlower, currentOutgoingEdge);
+
 		// Set new stem subflower.
-		flower->stemSubFlower = outgoingSubFlower;
+		currentFlower->stemSubFlower = outgoingSubFlower;
 	}
-
-	return pathEdges;
 }
 
-void dismantleTree(Flower *flower)
+void dismantleTree(Flower *flower, EventQueue &eventQueue)
 {
 	STD_VECTOR_FOREACH_(Flower *, flower->children, flowerIt, flowerEnd) {
-		setBlockingEdgeToRegular(flower, *flowerIt);
-		dismantleTree(*flowerIt);		
+		setBlockingEdgeToRegular((*flowerIt)->parentEdge, flower, *flowerIt, eventQueue.flowers());
+		dismantleTree(*flowerIt, eventQueue);
 	}
 
-	flower->type = Flower::Type::IN_DUMBBELL;
+	setFlowerType(flower, Flower::Type::IN_DUMBBELL, eventQueue);
+	flower->treeId = -1;
 	flower->parent = nullptr;
+	flower->parentEdge = nullptr;
 	flower->children.clear();
 }
 
@@ -392,8 +417,21 @@ void swapBlockingAndInPairningEdgeType(Edge *edge)
 	}
 }
 
-void executeCollapseTree(Edge *minEdge, std::vector<Flower *> &freeFlowers)
+// The types are swapped only after the whole path is collected, as it is found by the in pairing edges.
+void swapAlternatingPathEdgeTypes(Flower *flower, Edge *outgoingEdge, const std::vector<Flower *> &flowers,
+	AlternatingPathBuffers &pathBuffers)
 {
+	pathBuffers.pathEdges.clear();
+	preprocessAlternatingPathEdges(flower, outgoingEdge, flowers, pathBuffers);
+	STD_VECTOR_FOREACH_(Edge *, pathBuffers.pathEdges, edgeIt, edgeEnd) {
+		swapBlockingAndInPairningEdgeType(*edgeIt);
+	}
+}
+
+void executeCollapseTree(Edge *minEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue,
+	AlternatingPathBuffers &pathBuffers)
+{
+	const std::vector<Flower *> &flowers(eventQueue.flowers());
 	minEdge->type = Edge::Type::FULL_IN_PAIRING;
 
 	for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
@@ -402,12 +440,7 @@ void executeCollapseTree(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 
 		FOREVER {
 			// Process the alternating path of the even flower.
-			{
-				std::vector<Edge *> alternatingPathEdges(preprocessAlternatingPathEdges(freeFlower, outgoingEdge));
-				STD_VECTOR_FOREACH_(Edge *, alternatingPathEdges, edgeIt, edgeEnd) {
-					swapBlockingAndInPairningEdgeType(*edgeIt);
-				}
-			}
+			swapAlternatingPathEdgeTypes(freeFlower, outgoingEdge, flowers, pathBuffers);
 
 			// Exit the loop if the even flower doesn't have an odd parent.
 			if (freeFlower->parent == nullptr) {
@@ -416,32 +449,60 @@ void executeCollapseTree(Edge *minEdge, std::vector<Flower *> &freeFlowers)
 			freeFlower = freeFlower->parent;
 
 			// Swap the type of the in pairing edge.
-			freeFlower->inPairingEdge()->type = Edge::Type::FULL_BLOCKING;
+			freeFlower->inPairingEdge(flowers)->type = Edge::Type::FULL_BLOCKING;
 
 			// Find and swap the type of the outgoing edge of the odd flower.			
-			STD_VECTOR_FOREACH_(Edge *, freeFlower->parent->edges, edgeIt, edgeEnd) {
-				outgoingEdge = *edgeIt;
-				bool isBlockingParentEdge((outgoingEdge->type == Edge::Type::FULL_BLOCKING)
-					&& (std::find(outgoingEdge->flowers.begin(), outgoingEdge->flowers.end(), freeFlower) != outgoingEdge->flowers.end()));
-				if (isBlockingParentEdge) {
-					outgoingEdge->type = Edge::Type::FULL_IN_PAIRING;
-					break;
-				}
-			}
+			outgoingEdge = checkLinkedEdge(freeFlower->parentEdge, freeFlower->parent, freeFlower, flowers);
+			outgoingEdge->type = Edge::Type::FULL_IN_PAIRING;
 
 			// Process the alternation path of the odd flower.
-			{
-				std::vector<Edge *> alternatingPathEdges(preprocessAlternatingPathEdges(freeFlower, outgoingEdge));
-				STD_VECTOR_FOREACH_(Edge *, alternatingPathEdges, edgeIt, edgeEnd) {
-					swapBlockingAndInPairningEdgeType(*edgeIt);
-				}
-			}
+			swapAlternatingPathEdgeTypes(freeFlower, outgoingEdge, flowers, pathBuffers);
 
 			// Loop iteration step.
 			freeFlower = freeFlower->parent;			
 		}
 		
 		// Recursively dismantle the tree into dumbbells.
-		dismantleTree(freeFlower);
+		dismantleTree(freeFlower, eventQueue);
 	}
+}
+
+void executeSplitDumbbell(Edge *pairingEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue)
+{
+	pairingEdge->type = Edge::Type::REGULAR;
+
+	// Each flower becomes the root of its own tree, identified by its blue stem just as initial trees are.
+	STD_VECTOR_FOREACH_(Flower *, freeFlowers, flowerIt, flowerEnd) {
+		Flower *freeFlower(*flowerIt);
+		setFlowerType(freeFlower, Flower::Type::EVEN_IN_TREE, eventQueue);
+		freeFlower->treeId = freeFlower->blueStem()->vertexId - 1;
+		freeFlower->setPairingEdge(nullptr);
+	}
+}
+
+void executeDissolveFlower(Flower *rootFlower, EventQueue &eventQueue)
+{
+	// The flower has no full outgoing edges, so none of its subflowers keeps a connection outside.
+	splitMembership(rootFlower);
+
+	// The stem subflower remains exposed, the others stay paired along the pairing edges of the cycle.
+	STD_VECTOR_FOREACH_(Flower *, rootFlower->subFlowers, flowerIt, flowerEnd) {
+		Flower *subFlower(*flowerIt);
+		if (subFlower == rootFlower->stemSubFlower) {
+			setFlowerType(subFlower, Flower::Type::EVEN_IN_TREE, eventQueue);
+			subFlower->treeId = rootFlower->treeId;
+		} else {
+			setFlowerType(subFlower, Flower::Type::IN_DUMBBELL, eventQueue);
+			subFlower->treeId = -1;
+		}
+	}
+
+	// Set all blocking edges of the cycle as regular.
+	for (int i(0), count(static_cast<int>(rootFlower->subFlowers.size())); i < count; ++i) {
+		setBlockingEdgeToRegular(rootFlower->cycleEdges[i], rootFlower->subFlowers[i], rootFlower->subFlowers[(i + 1) % count],
+			eventQueue.flowers());
+	}
+
+	// Remove the flower from the queue.
+	detachGreenFlower(rootFlower, eventQueue);
 }
\ No newline at end of file
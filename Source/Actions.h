@@ -1,20 +1,42 @@
 #ifndef EDMONDS_ALGORITHM_ACTIONS_H
 #define EDMONDS_ALGORITHM_ACTIONS_H
 
+#include "EventQueue.h"
+#include "Pool.h"
 #include "Types.h"
 
+#include <utility>
 #include <vector>
 
+// Buffers reused by every (P4), so that the alternating paths are collected without allocations.
+struct AlternatingPathBuffers
+{
+	// Edges whose type is swapped along the path.
+	std::vector<Edge *> pathEdges;
+
+	// Flowers whose cycles remain to be walked, each with the edge by which the path leaves it.
+	std::vector<std::pair<Flower *, Edge *>> pendingFlowers;
+};
+
 // Implementation of (P1).
-void executeBurstFlower(Flower *greenFlower);
+void executeBurstFlower(Flower *greenFlower, EventQueue &eventQueue);
 
 // Implementation of (P2).
-void executeAppendDumbbell(Edge *minEdge, std::vector<Flower *> &freeFlowers);
+void executeAppendDumbbell(Edge *minEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue);
 
 // Implementation of (P3).
-Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers);
+Flower *executeCreateFlower(Edge *minEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue,
+	Pool<Flower> &flowerPool);
 
 // Implementation of (P4).
-void executeCollapseTree(Edge *minEdge, std::vector<Flower *> &freeFlowers);
+void executeCollapseTree(Edge *minEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue,
+	AlternatingPathBuffers &pathBuffers);
+
+// Splits a dumbbell into two trees, each of which consists of its root only.
+void executeSplitDumbbell(Edge *pairingEdge, std::vector<Flower *> &freeFlowers, EventQueue &eventQueue);
+
+// Dissolves a green flower that is the root of a tree without children.
+// Its stem subflower becomes the root, the other subflowers become dumbbells along the pairing edges of its cycle.
+void executeDissolveFlower(Flower *rootFlower, EventQueue &eventQueue);
 
 #endif // EDMONDS_ALGORITHM_ACTIONS_H
\ No newline at end of file
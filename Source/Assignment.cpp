@@ -0,0 +1,250 @@
+#include "Assignment.h"
+
+#include "Loader.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+AssignmentStatistics::AssignmentStatistics()
+: searchCount(0)
+, scannedEdgeCount(0)
+{}
+
+void AssignmentStatistics::writeJson(std::ostream &stream) const
+{
+	stream << "{\"engine\":\"assignment\",\"searches\":" << this->searchCount
+		<< ",\"scannedEdges\":" << this->scannedEdgeCount << "}";
+}
+
+AssignmentResult::AssignmentResult()
+: weight(0.0)
+, isPerfect(false)
+{}
+
+bool findBipartition(const InputGraph &graph, std::vector<char> &vertexSides)
+{
+	int vertexCount(graph.vertexCount);
+	std::vector<int> incidentOffsets(vertexCount + 1, 0);
+	STD_VECTOR_CONST_FOREACH_(InputEdge, graph.edges, edgeIt, edgeEnd) {
+		++incidentOffsets[edgeIt->vertexIds[0]];
+		++incidentOffsets[edgeIt->vertexIds[1]];
+	}
+	for (int i(0); i < vertexCount; ++i) {
+		incidentOffsets[i + 1] += incidentOffsets[i];
+	}
+	std::vector<int> neighbours(incidentOffsets[vertexCount]);
+	std::vector<int> neighbourPositions(incidentOffsets.begin(), incidentOffsets.end() - 1);
+	STD_VECTOR_CONST_FOREACH_(InputEdge, graph.edges, edgeIt, edgeEnd) {
+		int vertexA(edgeIt->vertexIds[0] - 1);
+		int vertexB(edgeIt->vertexIds[1] - 1);
+		neighbours[neighbourPositions[vertexA]++] = vertexB;
+		neighbours[neighbourPositions[vertexB]++] = vertexA;
+	}
+
+	// Each component starts on side 0 at its first vertex and is colored breadth first.
+	vertexSides.assign(vertexCount, -1);
+	std::vector<int> pendingVertices;
+	for (int i(0); i < vertexCount; ++i) {
+		if (vertexSides[i] >= 0) {
+			continue;
+		}
+		vertexSides[i] = 0;
+		pendingVertices.assign(1, i);
+		for (std::vector<int>::size_type j(0); j < pendingVertices.size(); ++j) {
+			int vertex(pendingVertices[j]);
+			for (int k(incidentOffsets[vertex]); k < incidentOffsets[vertex + 1]; ++k) {
+				int neighbour(neighbours[k]);
+				if (vertexSides[neighbour] < 0) {
+					vertexSides[neighbour] = 1 - vertexSides[vertex];
+					pendingVertices.push_back(neighbour);
+				} else if (vertexSides[neighbour] == vertexSides[vertex]) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+void solveAssignment(const InputGraph &graph, const std::vector<char> &vertexSides, AssignmentResult &result)
+{
+	const double INFINITE_DISTANCE(std::numeric_limits<double>::infinity());
+	int vertexCount(graph.vertexCount);
+	const std::vector<InputEdge> &edges(graph.edges);
+	result = AssignmentResult();
+
+	// Edges are only followed from side 0 while unpaired, so each vertex of side 0 owns a slice of its edges.
+	std::vector<int> incidentOffsets(vertexCount + 1, 0);
+	std::vector<int> edgeLeftVertices(edges.size());
+	for (int i(0), edgeCount(static_cast<int>(edges.size())); i < edgeCount; ++i) {
+		edgeLeftVertices[i] = edges[i].vertexIds[(vertexSides[edges[i].vertexIds[0] - 1] == 0) ? 0 : 1] - 1;
+		++incidentOffsets[edgeLeftVertices[i] + 1];
+	}
+	for (int i(0); i < vertexCount; ++i) {
+		incidentOffsets[i + 1] += incidentOffsets[i];
+	}
+	std::vector<int> incidentEdges(incidentOffsets[vertexCount]);
+	std::vector<int> incidentPositions(incidentOffsets.begin(), incidentOffsets.end() - 1);
+	for (int i(0), edgeCount(static_cast<int>(edges.size())); i < edgeCount; ++i) {
+		incidentEdges[incidentPositions[edgeLeftVertices[i]]++] = i;
+	}
+
+	// A paired edge is followed backwards with the negated weight. The potentials keep every reduced weight
+	// nonnegative, starting with the lightest edge at each vertex of side 1 and then the lightest reduced edge
+	// at each vertex of side 0.
+	std::vector<double> potentials(vertexCount, 0.0);
+	std::vector<bool> hasPotential(vertexCount, false);
+	for (int i(0), edgeCount(static_cast<int>(edges.size())); i < edgeCount; ++i) {
+		int rightVertex(edges[i].vertexIds[0] + edges[i].vertexIds[1] - 2 - edgeLeftVertices[i]);
+		if (!hasPotential[rightVertex] || (edges[i].weight < potentials[rightVertex])) {
+			potentials[rightVertex] = edges[i].weight;
+			hasPotential[rightVertex] = true;
+		}
+	}
+
+	for (int i(0); i < vertexCount; ++i) {
+		for (int j(incidentOffsets[i]); j < incidentOffsets[i + 1]; ++j) {
+			int edge(incidentEdges[j]);
+			int neighbour(edges[edge].vertexIds[0] + edges[edge].vertexIds[1] - 2 - i);
+			double reducedWeight(edges[edge].weight - potentials[neighbour]);
+			if ((j == incidentOffsets[i]) || (-reducedWeight > potentials[i])) {
+				potentials[i] = -reducedWeight;
+			}
+		}
+	}
+
+	// Edges of reduced weight zero can be paired right away, which leaves the searches to the contested vertices.
+	std::vector<int> mateEdges(vertexCount, -1);
+	for (int i(0); i < vertexCount; ++i) {
+		for (int j(incidentOffsets[i]); (j < incidentOffsets[i + 1]) && (mateEdges[i] < 0); ++j) {
+			int edge(incidentEdges[j]);
+			int neighbour(edges[edge].vertexIds[0] + edges[edge].vertexIds[1] - 2 - i);
+			if ((mateEdges[neighbour] < 0) && (edges[edge].weight + potentials[i] - potentials[neighbour] == 0.0)) {
+				mateEdges[i] = edge;
+				mateEdges[neighbour] = edge;
+			}
+		}
+	}
+
+	std::vector<double> distances(vertexCount, INFINITE_DISTANCE);
+	std::vector<int> previousEdges(vertexCount, -1);
+	std::vector<int> reachedVertices;
+	// Min-heap of reached vertices by distance, which may hold stale entries of vertices that got closer since.
+	typedef std::pair<double, int> QueueEntry;
+	std::vector<QueueEntry> queue;
+
+	for (int source(0); source < vertexCount; ++source) {
+		if ((vertexSides[source] != 0) || (mateEdges[source] >= 0) || (incidentOffsets[source] == incidentOffsets[source + 1])) {
+			continue;
+		}
+		++result.statistics.searchCount;
+		distances[source] = 0.0;
+		reachedVertices.push_back(source);
+		queue.push_back(QueueEntry(0.0, source));
+
+		// The first unpaired vertex of side 1 taken from the queue ends a shortest augmenting path.
+		int pathEnd(-1);
+		double pathLength(INFINITE_DISTANCE);
+		while ((pathEnd < 0) && !queue.empty()) {
+			std::pop_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+			QueueEntry entry(queue.back());
+			queue.pop_back();
+			int vertex(entry.second);
+			if (entry.first > distances[vertex]) {
+				continue;
+			}
+
+			if (vertexSides[vertex] == 1) {
+				if (mateEdges[vertex] < 0) {
+					pathEnd = vertex;
+					pathLength = entry.first;
+					break;
+				}
+				int mateEdge(mateEdges[vertex]);
+				int mate(edgeLeftVertices[mateEdge]);
+				double distance(entry.first - edges[mateEdge].weight + potentials[vertex] - potentials[mate]);
+				if (distance < distances[mate]) {
+					if (distances[mate] == INFINITE_DISTANCE) {
+						reachedVertices.push_back(mate);
+					}
+					distances[mate] = distance;
+					queue.push_back(QueueEntry(distance, mate));
+					std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+				}
+				continue;
+			}
+
+			for (int i(incidentOffsets[vertex]); i < incidentOffsets[vertex + 1]; ++i) {
+				int edge(incidentEdges[i]);
+				int neighbour(edges[edge].vertexIds[0] + edges[edge].vertexIds[1] - 2 - vertex);
+				++result.statistics.scannedEdgeCount;
+				if (edge == mateEdges[vertex]) {
+					continue;
+				}
+				double distance(entry.first + edges[edge].weight + potentials[vertex] - potentials[neighbour]);
+				if (distance < distances[neighbour]) {
+					if (distances[neighbour] == INFINITE_DISTANCE) {
+						reachedVertices.push_back(neighbour);
+					}
+					distances[neighbour] = distance;
+					previousEdges[neighbour] = edge;
+
+					// No path is shorter than one ending on a tight edge, so the search can stop before the queue.
+					if ((mateEdges[neighbour] < 0) && (distance == entry.first)) {
+						pathEnd = neighbour;
+						pathLength = distance;
+						break;
+					}
+					queue.push_back(QueueEntry(distance, neighbour));
+					std::push_heap(queue.begin(), queue.end(), std::greater<QueueEntry>());
+				}
+			}
+		}
+		queue.clear();
+
+		// Each reached vertex moves by its distance, capped at the path length, and every vertex moves back by the path length,
+		// which leaves the unreached vertices as they are and keeps all reduced weights nonnegative.
+		STD_VECTOR_CONST_FOREACH_(int, reachedVertices, vertexIt, vertexEnd) {
+			if (pathEnd >= 0) {
+				potentials[*vertexIt] += std::min(distances[*vertexIt], pathLength) - pathLength;
+			}
+			distances[*vertexIt] = INFINITE_DISTANCE;
+		}
+		reachedVertices.clear();
+
+		// The source stays unpaired if no path reaches an unpaired vertex of side 1.
+		if (pathEnd < 0) {
+			continue;
+		}
+
+		// Pair the edges along the path, which unpairs the edges between them.
+		int rightVertex(pathEnd);
+		FOREVER {
+			int edge(previousEdges[rightVertex]);
+			int leftVertex(edgeLeftVertices[edge]);
+			int previousMateEdge(mateEdges[leftVertex]);
+			mateEdges[rightVertex] = edge;
+			mateEdges[leftVertex] = edge;
+			if (previousMateEdge < 0) {
+				break;
+			}
+			rightVertex = edges[previousMateEdge].vertexIds[0] + edges[previousMateEdge].vertexIds[1] - 2 - leftVertex;
+		}
+	}
+
+	result.isPerfect = true;
+	for (int i(0); i < vertexCount; ++i) {
+		if (mateEdges[i] < 0) {
+			result.isPerfect = false;
+		} else if (vertexSides[i] == 0) {
+			result.pairingEdges.push_back(mateEdges[i]);
+			result.weight += edges[mateEdges[i]].weight;
+		}
+	}
+	std::sort(result.pairingEdges.begin(), result.pairingEdges.end());
+}
\ No newline at end of file
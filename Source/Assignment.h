@@ -0,0 +1,44 @@
+#ifndef EDMONDS_ALGORITHM_ASSIGNMENT_H
+#define EDMONDS_ALGORITHM_ASSIGNMENT_H
+
+#include "Loader.h"
+
+#include <ostream>
+#include <vector>
+
+// Counts of the work done by the last assignment solve.
+struct AssignmentStatistics
+{
+	// Shortest path searches, each of which tries to pair one more vertex of side 0.
+	long long searchCount;
+	// Edges relaxed by all searches.
+	long long scannedEdgeCount;
+
+	AssignmentStatistics();
+
+	// Writes all values as one JSON object on a single line.
+	void writeJson(std::ostream &stream) const;
+};
+
+// Pairing found for a bipartite graph.
+struct AssignmentResult
+{
+	double weight;
+	bool isPerfect;
+	// Indices of the paired edges within the input graph, in increasing order.
+	std::vector<int> pairingEdges;
+	AssignmentStatistics statistics;
+
+	AssignmentResult();
+};
+
+// Colors the vertices with the sides 0 and 1 so that every edge joins both sides.
+// Returns false if the graph has an odd cycle, which includes loops.
+bool findBipartition(const InputGraph &graph, std::vector<char> &vertexSides);
+
+// Finds a pairing of minimum weight in a listed bipartite graph, which is perfect if one exists.
+// Each vertex of side 0 is paired in turn through a shortest augmenting path, found by Dijkstra's algorithm
+// on the weights reduced by the potentials of the vertices, just as in the Hungarian method, so no flowers are ever needed.
+void solveAssignment(const InputGraph &graph, const std::vector<char> &vertexSides, AssignmentResult &result);
+
+#endif // EDMONDS_ALGORITHM_ASSIGNMENT_H
\ No newline at end of file
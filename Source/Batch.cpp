@@ -0,0 +1,260 @@
+#include "Batch.h"
+
+#include "Loader.h"
+#include "MatchingSolver.h"
+#include "Pricing.h"
+#include "ThreadPool.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+BatchOptions::BatchOptions()
+: format(InputFormat::AUTO)
+, threadCount(1)
+, candidateCount(0)
+, isWarmStartEnabled(true)
+{}
+
+BatchStatistics::BatchStatistics()
+: instanceCount(0)
+, failedInstanceCount(0)
+, imperfectInstanceCount(0)
+, wallSeconds(0.0)
+{}
+
+double BatchStatistics::instancesPerSecond() const
+{
+	return (this->wallSeconds > 0.0) ? this->instanceCount / this->wallSeconds : 0.0;
+}
+
+bool isDirectory(const char *path)
+{
+#ifdef _WIN32
+	DWORD attributes(GetFileAttributesA(path));
+	return (attributes != INVALID_FILE_ATTRIBUTES) && ((attributes & FILE_ATTRIBUTE_DIRECTORY) != 0);
+#else
+	struct stat fileStatus;
+	return (stat(path, &fileStatus) == 0) && S_ISDIR(fileStatus.st_mode);
+#endif
+}
+
+bool isAbsolutePath(const std::string &path)
+{
+	return (!path.empty() && ((path[0] == '/') || (path[0] == '\\'))) || ((path.size() > 1) && (path[1] == ':'));
+}
+
+// Returns the path up to and including its last separator, or nothing if it has none.
+std::string directoryPrefix(const std::string &path)
+{
+	std::string::size_type separator(path.find_last_of("/\\"));
+	return (separator == std::string::npos) ? std::string() : path.substr(0, separator + 1);
+}
+
+bool listDirectory(const std::string &directory, std::vector<std::string> &instancePaths)
+{
+	std::string prefix(directory);
+	if ((prefix.back() != '/') && (prefix.back() != '\\')) {
+		prefix += '/';
+	}
+
+	std::vector<std::string> names;
+#ifdef _WIN32
+	WIN32_FIND_DATAA findData;
+	HANDLE findHandle(FindFirstFileA((prefix + "*").c_str(), &findData));
+	if (findHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	do {
+		if ((findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
+			names.push_back(findData.cFileName);
+		}
+	} while (FindNextFileA(findHandle, &findData));
+	FindClose(findHandle);
+#else
+	DIR *directoryStream(opendir(directory.c_str()));
+	if (directoryStream == nullptr) {
+		return false;
+	}
+	while (dirent *entry = readdir(directoryStream)) {
+		if (!isDirectory((prefix + entry->d_name).c_str())) {
+			names.push_back(entry->d_name);
+		}
+	}
+	closedir(directoryStream);
+#endif
+
+	// Hidden files are not instances.
+	std::sort(names.begin(), names.end());
+	STD_VECTOR_CONST_FOREACH_(std::string, names, nameIt, nameEnd) {
+		if ((*nameIt)[0] != '.') {
+			instancePaths.push_back(prefix + *nameIt);
+		}
+	}
+	return true;
+}
+
+bool readManifest(const std::string &manifestPath, std::vector<std::string> &instancePaths)
+{
+	std::ifstream manifest(manifestPath);
+	if (!manifest) {
+		return false;
+	}
+
+	std::string prefix(directoryPrefix(manifestPath));
+	std::string line;
+	while (std::getline(manifest, line)) {
+		std::string::size_type first(line.find_first_not_of(" \t\r"));
+		if ((first == std::string::npos) || (line[first] == '#')) {
+			continue;
+		}
+		std::string instancePath(line.substr(first, line.find_last_not_of(" \t\r") - first + 1));
+		instancePaths.push_back(isAbsolutePath(instancePath) ? instancePath : prefix + instancePath);
+	}
+	return true;
+}
+
+bool collectInstancePaths(const char *path, std::vector<std::string> &instancePaths, const char *&errorMessage)
+{
+	instancePaths.clear();
+	if (isDirectory(path)) {
+		if (!listDirectory(path, instancePaths)) {
+			errorMessage = "The batch directory could not be listed.";
+			return false;
+		}
+	} else if (!readManifest(path, instancePaths)) {
+		errorMessage = "The batch manifest could not be read.";
+		return false;
+	}
+	return true;
+}
+
+void writeJsonString(const std::string &value, std::ostream &stream)
+{
+	stream << '"';
+	for (std::string::size_type i(0); i < value.size(); ++i) {
+		char character(value[i]);
+		if ((character == '"') || (character == '\\')) {
+			stream << '\\' << character;
+		} else if (static_cast<unsigned char>(character) < 0x20) {
+			char escaped[8];
+			std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+			stream << escaped;
+		} else {
+			stream << character;
+		}
+	}
+	stream << '"';
+}
+
+// Loads and solves one instance with the solver of the calling thread, and writes its JSON object to the record.
+// Returns false if the instance failed.
+bool solveInstance(const std::string &instancePath, const BatchOptions &options, MatchingSolver &solver,
+	std::ostream &record, bool &isPerfect)
+{
+	std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+	record << "{\"instance\":";
+	writeJsonString(instancePath, record);
+
+	const char *errorMessage(nullptr);
+	InputGraph graph;
+	bool isSolved(loadGraph(instancePath.c_str(), options.format, options.candidateCount > 0, graph, errorMessage));
+	if (isSolved) {
+		if (options.candidateCount > 0) {
+			PricingStatistics pricingStatistics;
+			isSolved = solveWithPricing(std::move(graph), options.candidateCount, solver, isPerfect, pricingStatistics,
+				errorMessage);
+		} else {
+			isSolved = solver.setGraph(std::move(graph), errorMessage);
+			if (isSolved) {
+				isPerfect = solver.solve();
+			}
+		}
+	}
+	if (!isSolved) {
+		record << ",\"error\":";
+		writeJsonString(errorMessage, record);
+		record << "}";
+		return false;
+	}
+
+	std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+	record << ",\"vertices\":" << solver.vertexCount()
+		<< ",\"weight\":" << std::setprecision(15) << solver.pairingWeight()
+		<< ",\"perfect\":" << (isPerfect ? "true" : "false")
+		<< ",\"seconds\":" << std::fixed << std::setprecision(6) << std::chrono::duration<double>(end - start).count()
+		<< ",\"pairing\":[";
+	const std::vector<int> &pairingEdges(solver.pairingEdges());
+	for (std::vector<int>::const_iterator edgeIt(pairingEdges.cbegin()), edgeEnd(pairingEdges.cend()); edgeIt != edgeEnd; ++edgeIt) {
+		record << ((edgeIt != pairingEdges.cbegin()) ? ",[" : "[") << solver.edgeVertex(*edgeIt, 0) + 1;
+		for (int i(1); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			record << "," << solver.edgeVertex(*edgeIt, i) + 1;
+		}
+		record << "]";
+	}
+	record << "]}";
+	return true;
+}
+
+void solveBatch(const std::vector<std::string> &instancePaths, const BatchOptions &options, std::ostream &output,
+	BatchStatistics &statistics)
+{
+	statistics = BatchStatistics();
+	statistics.instanceCount = static_cast<int>(instancePaths.size());
+	std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+	// Each thread keeps its own solver, so that the flowers and edges are never shared and their memory is reused.
+	ThreadPool threadPool(options.threadCount);
+	std::vector<MatchingSolver> solvers(threadPool.threadCount());
+	STD_VECTOR_FOREACH_(MatchingSolver, solvers, solverIt, solverEnd) {
+		solverIt->setWarmStartEnabled(options.isWarmStartEnabled);
+	}
+
+	// Records finished out of order wait until all records before them are written.
+	std::mutex outputMutex;
+	std::vector<std::string> records(instancePaths.size());
+	std::vector<bool> isRecordDone(instancePaths.size(), false);
+	int nextRecord(0);
+
+	threadPool.runStealing(statistics.instanceCount, [&](int threadIndex, int instance) {
+		std::ostringstream record;
+		bool isPerfect(false);
+		bool isSolved(solveInstance(instancePaths[instance], options, solvers[threadIndex], record, isPerfect));
+
+		std::lock_guard<std::mutex> lock(outputMutex);
+		if (!isSolved) {
+			++statistics.failedInstanceCount;
+		} else if (!isPerfect) {
+			++statistics.imperfectInstanceCount;
+		}
+		records[instance] = record.str();
+		isRecordDone[instance] = true;
+		while ((nextRecord < statistics.instanceCount) && isRecordDone[nextRecord]) {
+			output << records[nextRecord] << '\n';
+			std::string().swap(records[nextRecord]);
+			++nextRecord;
+		}
+	});
+	output.flush();
+
+	std::chrono::steady_clock::time_point end(std::chrono::steady_clock::now());
+	statistics.wallSeconds = std::chrono::duration<double>(end - start).count();
+}
\ No newline at end of file
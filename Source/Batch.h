@@ -0,0 +1,49 @@
+#ifndef EDMONDS_ALGORITHM_BATCH_H
+#define EDMONDS_ALGORITHM_BATCH_H
+
+#include "Loader.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Settings shared by all instances of a batch.
+struct BatchOptions
+{
+	InputFormat format;
+	// Instances solved at the same time, each by its own solver.
+	int threadCount;
+	// Solves each instance with pricing on this many lightest edges of each vertex if positive, see solveWithPricing.
+	int candidateCount;
+	bool isWarmStartEnabled;
+
+	BatchOptions();
+};
+
+// Counts of the last batch.
+struct BatchStatistics
+{
+	int instanceCount;
+	// Instances that could not be loaded or solved.
+	int failedInstanceCount;
+	// Instances without a perfect pairing.
+	int imperfectInstanceCount;
+	double wallSeconds;
+
+	BatchStatistics();
+
+	double instancesPerSecond() const;
+};
+
+// Collects the instances of a batch from a manifest listing one path per line, or from all files of a directory.
+// Empty lines and lines starting with '#' are skipped, and relative paths are taken relative to the manifest.
+// The files of a directory are taken in the order of their names.
+// On failure an error message is stored and false is returned.
+bool collectInstancePaths(const char *path, std::vector<std::string> &instancePaths, const char *&errorMessage);
+
+// Solves all instances and writes one JSON object per instance and line to the output, in the order of the paths.
+// The instances are spread over a pool of threads, where a thread that runs out of instances steals them from the others.
+void solveBatch(const std::vector<std::string> &instancePaths, const BatchOptions &options, std::ostream &output,
+	BatchStatistics &statistics);
+
+#endif // EDMONDS_ALGORITHM_BATCH_H
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "Components.h"
+
+#include "Loader.h"
+#include "MatchingSolver.h"
+#include "Pricing.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+#include "Utility.h"
+
+#include <utility>
+#include <vector>
+
+ComponentOptions::ComponentOptions()
+: threadCount(1)
+, candidateCount(0)
+, isWarmStartEnabled(true)
+, isStatisticsEnabled(false)
+{}
+
+ComponentPairing::ComponentPairing()
+: weight(0.0)
+, isPerfect(true)
+{}
+
+// Pairing of a single component, with the vertex ids of the whole graph.
+struct ComponentResult
+{
+	double weight;
+	bool isPerfect;
+	const char *errorMessage;
+	std::vector<InputEdge> edges;
+
+	ComponentResult()
+	: weight(0.0)
+	, isPerfect(false)
+	, errorMessage(nullptr)
+	{}
+};
+
+int findRoot(std::vector<int> &parents, int vertex)
+{
+	// Halve the path on the way up, so that later searches are shorter.
+	while (parents[vertex] != vertex) {
+		parents[vertex] = parents[parents[vertex]];
+		vertex = parents[vertex];
+	}
+	return vertex;
+}
+
+int findComponents(const InputGraph &graph, std::vector<int> &vertexComponents)
+{
+	std::vector<int> parents(graph.vertexCount);
+	for (int i(0); i < graph.vertexCount; ++i) {
+		parents[i] = i;
+	}
+	STD_VECTOR_CONST_FOREACH_(InputEdge, graph.edges, edgeIt, edgeEnd) {
+		int rootA(findRoot(parents, edgeIt->vertexIds[0] - 1));
+		int rootB(findRoot(parents, edgeIt->vertexIds[1] - 1));
+		// The smaller root is kept, so that every root is the first vertex of its component.
+		if (rootA < rootB) {
+			parents[rootB] = rootA;
+		} else {
+			parents[rootA] = rootB;
+		}
+	}
+
+	// Roots come before the rest of their component, so they are numbered first.
+	int componentCount(0);
+	vertexComponents.assign(graph.vertexCount, -1);
+	for (int i(0); i < graph.vertexCount; ++i) {
+		int root(findRoot(parents, i));
+		if (root == i) {
+			vertexComponents[i] = componentCount++;
+		} else {
+			vertexComponents[i] = vertexComponents[root];
+		}
+	}
+	return componentCount;
+}
+
+void solveComponent(InputGraph &&componentGraph, const std::vector<int> &vertexIds, const ComponentOptions &options,
+	MatchingSolver &solver, ComponentResult &result, SolverStatistics &statistics)
+{
+	// A component without edges is a single vertex, which stays unpaired.
+	if (componentGraph.edges.empty()) {
+		return;
+	}
+
+	bool isSolved(false);
+	if (options.candidateCount > 0) {
+		PricingStatistics pricingStatistics;
+		isSolved = solveWithPricing(std::move(componentGraph), options.candidateCount, solver, result.isPerfect,
+			pricingStatistics, result.errorMessage);
+	} else if (solver.setGraph(std::move(componentGraph), result.errorMessage)) {
+		result.isPerfect = solver.solve();
+		isSolved = true;
+	}
+	if (!isSolved) {
+		return;
+	}
+
+	statistics.add(solver.statistics());
+	result.weight = solver.pairingWeight();
+	const std::vector<int> &pairingEdges(solver.pairingEdges());
+	for (std::vector<int>::const_reverse_iterator edgeIt(pairingEdges.crbegin()), edgeEnd(pairingEdges.crend());
+		edgeIt != edgeEnd; ++edgeIt) {
+		InputEdge edge;
+		for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			edge.vertexIds[i] = vertexIds[solver.edgeVertex(*edgeIt, i)];
+		}
+		edge.weight = solver.edgeWeight(*edgeIt);
+		result.edges.push_back(edge);
+	}
+}
+
+bool solveComponents(const InputGraph &graph, const std::vector<int> &vertexComponents, int componentCount,
+	const ComponentOptions &options, ComponentPairing &pairing, const char *&errorMessage)
+{
+	// Renumber the vertices within their components, remembering their ids in the whole graph.
+	std::vector<InputGraph> componentGraphs(componentCount);
+	std::vector<std::vector<int>> componentVertexIds(componentCount);
+	std::vector<int> localVertexIds(graph.vertexCount);
+	for (int i(0); i < graph.vertexCount; ++i) {
+		InputGraph &componentGraph(componentGraphs[vertexComponents[i]]);
+		localVertexIds[i] = componentGraph.vertexCount++;
+		componentVertexIds[vertexComponents[i]].push_back(i + 1);
+	}
+	STD_VECTOR_CONST_FOREACH_(InputEdge, graph.edges, edgeIt, edgeEnd) {
+		InputEdge edge(*edgeIt);
+		for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			edge.vertexIds[i] = localVertexIds[edgeIt->vertexIds[i] - 1] + 1;
+		}
+		componentGraphs[vertexComponents[edgeIt->vertexIds[0] - 1]].edges.push_back(edge);
+	}
+
+	// Each thread keeps its own solver and statistics, so that nothing is shared while the components are solved.
+	ThreadPool threadPool(options.threadCount);
+	std::vector<MatchingSolver> solvers(threadPool.threadCount());
+	std::vector<SolverStatistics> threadStatistics(threadPool.threadCount());
+	STD_VECTOR_FOREACH_(MatchingSolver, solvers, solverIt, solverEnd) {
+		solverIt->setWarmStartEnabled(options.isWarmStartEnabled);
+		solverIt->setStatisticsEnabled(options.isStatisticsEnabled);
+	}
+
+	std::vector<ComponentResult> results(componentCount);
+	threadPool.runStealing(componentCount, [&](int threadIndex, int component) {
+		solveComponent(std::move(componentGraphs[component]), componentVertexIds[component], options,
+			solvers[threadIndex], results[component], threadStatistics[threadIndex]);
+	});
+
+	// Merge in the order of the components, so that the output does not depend on the threads.
+	pairing = ComponentPairing();
+	STD_VECTOR_CONST_FOREACH_(ComponentResult, results, resultIt, resultEnd) {
+		if (resultIt->errorMessage != nullptr) {
+			errorMessage = resultIt->errorMessage;
+			return false;
+		}
+		pairing.weight += resultIt->weight;
+		pairing.isPerfect = pairing.isPerfect && resultIt->isPerfect;
+		pairing.edges.insert(pairing.edges.end(), resultIt->edges.begin(), resultIt->edges.end());
+	}
+	STD_VECTOR_CONST_FOREACH_(SolverStatistics, threadStatistics, statisticsIt, statisticsEnd) {
+		pairing.statistics.add(*statisticsIt);
+	}
+	return true;
+}
\ No newline at end of file
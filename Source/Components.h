@@ -0,0 +1,46 @@
+#ifndef EDMONDS_ALGORITHM_COMPONENTS_H
+#define EDMONDS_ALGORITHM_COMPONENTS_H
+
+#include "Loader.h"
+#include "Statistics.h"
+
+#include <vector>
+
+// Settings shared by the solvers of all components.
+struct ComponentOptions
+{
+	// Components solved at the same time, each by its own solver.
+	int threadCount;
+	// Solves each component with pricing on this many lightest edges of each vertex if positive, see solveWithPricing.
+	int candidateCount;
+	bool isWarmStartEnabled;
+	bool isStatisticsEnabled;
+
+	ComponentOptions();
+};
+
+// Pairings of all components merged into one.
+struct ComponentPairing
+{
+	double weight;
+	// Whether every component has a perfect pairing.
+	bool isPerfect;
+	// Paired edges with the vertex ids of the whole graph, by component and in the output order of each solver.
+	std::vector<InputEdge> edges;
+	// Statistics of all component solves added together.
+	SolverStatistics statistics;
+
+	ComponentPairing();
+};
+
+// Stores the connected component of every vertex, numbered in the order of their first vertex, and returns their count.
+int findComponents(const InputGraph &graph, std::vector<int> &vertexComponents);
+
+// Solves every connected component of a listed graph by its own solver and merges their pairings.
+// Powers of different components never meet on an edge, so the merged pairing is optimal for the whole graph.
+// The components are spread over a pool of threads, where a thread that runs out of components steals them from the others.
+// On failure an error message is stored and false is returned.
+bool solveComponents(const InputGraph &graph, const std::vector<int> &vertexComponents, int componentCount,
+	const ComponentOptions &options, ComponentPairing &pairing, const char *&errorMessage);
+
+#endif // EDMONDS_ALGORITHM_COMPONENTS_H
\ No newline at end of file
@@ -1,90 +1,67 @@
 #include "Evaluation.h"
 
+#include "EventQueue.h"
 #include "Types.h"
 #include "Utility.h"
 
 #include <vector>
-#include <limits>
 
-double findMinEdgeEpsilon(Edge *&minEdge, const std::vector<Edge *> &edges)
+Weight findMinEdgeEpsilon(Edge *&minEdge, const EventQueue &eventQueue)
 {
 	// INVARIANT: No change to the graph state occurs here.
 
-	double minEpsilon(std::numeric_limits<double>::max());
-
-	STD_VECTOR_CONST_FOREACH_(Edge *, edges, edgeIt, edgeEnd) {
-		Edge *edge(*edgeIt);
-
-		if (!edge->isFull()) {
-			double weightPadding(edge->weight);
-			int incrementableFlowerCount(0);
-
-			STD_VECTOR_CONST_FOREACH_(Flower *, edge->flowers, flowerIt, flowerEnd) {
-				const Flower *flower(*flowerIt);
-
-				weightPadding -= flower->power;
-
-				switch (flower->type) {
-				case Flower::Type::EVEN_IN_TREE:
-					++incrementableFlowerCount;
-					break;
-				case Flower::Type::ODD_IN_TREE:
-					--incrementableFlowerCount;
-					break;
-				}
-			}
-
-			// Test if edge is full and if the epsilon value has an upper bound.
-			double maxEpsilon(weightPadding);
-			if (incrementableFlowerCount > 0) {
-				maxEpsilon /= static_cast<double>(incrementableFlowerCount);
-				if (minEpsilon > maxEpsilon) {
-					minEpsilon = maxEpsilon;
-					minEdge = edge;
-				}
-			}
-		}
-	}
+	return eventQueue.minEdgeEpsilon(minEdge);
+}
+
+Weight findMinGreenFlowerEpsilon(Flower *&minGreenFlower, const EventQueue &eventQueue)
+{
+	// INVARIANT: No change to the graph state occurs here.
 
-	return minEpsilon;
+	return eventQueue.minGreenFlowerEpsilon(minGreenFlower);
 }
 
-double findMinGreenFlowerEpsilon(Flower *&minGreenFlower, const std::vector<Flower *> &flowers)
+void findMinEdges(Weight minEdgeEpsilon, std::vector<Edge *> &minEdges, const EventQueue &eventQueue)
 {
 	// INVARIANT: No change to the graph state occurs here.
 
-	double minEpsilon(std::numeric_limits<double>::max());
+	eventQueue.collectMinEdges(minEdgeEpsilon, minEdges);
+}
 
-	STD_VECTOR_CONST_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
-		Flower *flower(*flowerIt);
+void findMinGreenFlowers(Weight minGreenFlowerEpsilon, std::vector<Flower *> &minGreenFlowers,
+	const EventQueue &eventQueue)
+{
+	// INVARIANT: No change to the graph state occurs here.
+
+	eventQueue.collectMinGreenFlowers(minGreenFlowerEpsilon, minGreenFlowers);
+}
 
-		// Only tree odd green flowers are affected.
-		if ((flower->type == Flower::Type::ODD_IN_TREE) && flower->isGreen()) {
-			if (minEpsilon > flower->power) {
-				minEpsilon = flower->power;
-				minGreenFlower = flower;
-			}
-		}
+bool testEdgeEventValidity(const Edge *edge, const std::vector<Flower *> &flowers)
+{
+	// INVARIANT: No change to the graph state occurs here.
+
+	// Actions keep all powers, so the edge still has no padding, but its flowers may have changed their types.
+	// Edges within one flower have no incrementable flowers.
+	if (edge->isFull()) {
+		return false;
 	}
 
-	return minEpsilon;
+	int incrementableFlowerCount(0);
+	edge->crossedPower(flowers, 0, incrementableFlowerCount);
+	return incrementableFlowerCount > 0;
 }
 
-void applyEpsilon(double epsilon, const std::vector<Flower *> &flowers)
+bool testGreenFlowerEventValidity(const Flower *greenFlower)
+{
+	// INVARIANT: No change to the graph state occurs here.
+
+	// The flower may have become a subflower or a part of a dumbbell.
+	return (greenFlower->type == Flower::Type::ODD_IN_TREE) && greenFlower->isGreen();
+}
+
+void applyEpsilon(Weight epsilon, EventQueue &eventQueue)
 {
 	// INVARIANT: Only the power of tree flowers changes here.
 
-	STD_VECTOR_CONST_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
-		Flower *flower(*flowerIt);
-
-		// Only tree flowers are affected.
-		switch (flower->type) {
-		case Flower::Type::EVEN_IN_TREE:
-			flower->power += epsilon;
-			break;
-		case Flower::Type::ODD_IN_TREE:
-			flower->power -= epsilon;
-			break;
-		}
-	}
+	// Tree flowers follow the dual offset, so their powers change without being touched.
+	eventQueue.applyEpsilon(epsilon);
 }
\ No newline at end of file
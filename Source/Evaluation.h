@@ -1,17 +1,31 @@
 #ifndef EDMONDS_ALGORITHM_EVALUATION_H
 #define EDMONDS_ALGORITHM_EVALUATION_H
 
+#include "EventQueue.h"
 #include "Types.h"
 
 #include <vector>
 
 // Checks for violations of (I1)
-double findMinEdgeEpsilon(Edge *&minEdge, const std::vector<Edge *> &edges);
+Weight findMinEdgeEpsilon(Edge *&minEdge, const EventQueue &eventQueue);
 
 // Checks for violations of (I2)
-double findMinGreenFlowerEpsilon(Flower *&minGreenFlower, const std::vector<Flower *> &flowers);
+Weight findMinGreenFlowerEpsilon(Flower *&minGreenFlower, const EventQueue &eventQueue);
+
+// Collects all edges that violate (I1) at the min epsilon, before it is applied.
+void findMinEdges(Weight minEdgeEpsilon, std::vector<Edge *> &minEdges, const EventQueue &eventQueue);
+
+// Collects all green flowers that violate (I2) at the min epsilon, before it is applied.
+void findMinGreenFlowers(Weight minGreenFlowerEpsilon, std::vector<Flower *> &minGreenFlowers,
+	const EventQueue &eventQueue);
+
+// Checks whether a collected edge still violates (I1) after the actions executed before it.
+bool testEdgeEventValidity(const Edge *edge, const std::vector<Flower *> &flowers);
+
+// Checks whether a collected green flower still violates (I2) after the actions executed before it.
+bool testGreenFlowerEventValidity(const Flower *greenFlower);
 
 // Apply power changes to flowers using the selected epsilon value.
-void applyEpsilon(double epsilon, const std::vector<Flower *> &flowers);
+void applyEpsilon(Weight epsilon, EventQueue &eventQueue);
 
 #endif // EDMONDS_ALGORITHM_EVALUATION_H
\ No newline at end of file
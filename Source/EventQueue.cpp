@@ -0,0 +1,382 @@
+#include "EventQueue.h"
+
+#include "IndexedHeap.h"
+#include "SlackKernel.h"
+#include "ThreadPool.h"
+#include "Types.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include <limits>
+
+// Below this number of edges a scan is not worth splitting between threads.
+const int MIN_PARALLEL_EDGE_COUNT(4096);
+
+// Returns the padding of the edge at the given dual offset and counts its incrementable flowers.
+// Full and removed edges have no incrementable flowers.
+Weight computeEdgePadding(const Edge *edge, const std::vector<Flower *> &flowers, Weight dualOffset,
+	int &incrementableFlowerCount)
+{
+	incrementableFlowerCount = 0;
+	if (edge->isFull() || edge->isRemoved) {
+		return edge->weight;
+	}
+
+	return edge->weight - edge->crossedPower(flowers, dualOffset, incrementableFlowerCount);
+}
+
+// Returns the free flower containing the flower. The flower and the flowers enclosing it are stamped with it and with
+// the powers crossed on the way up, so that within one refresh every chain of enclosing flowers is only walked once.
+// Flowers within a free flower are internal, so their powers do not follow the dual offset.
+Flower *stampChain(Flower *flower, int stamp)
+{
+	// Walk up to the first flower that is already stamped or free.
+	Flower *topFlower(flower);
+	Weight power(0);
+	while ((topFlower->chainStamp != stamp) && (topFlower->enclosingFlower != nullptr)) {
+		power += topFlower->stampedPower;
+		topFlower = topFlower->enclosingFlower;
+	}
+	if (topFlower->chainStamp != stamp) {
+		topFlower->chainStamp = stamp;
+		topFlower->chainOuterFlower = topFlower;
+		topFlower->chainPower = 0;
+	}
+	power += topFlower->chainPower;
+	Flower *outerFlower(topFlower->chainOuterFlower);
+
+	// Stamp the flowers below it, each with the powers from itself up to the free flower.
+	for (Flower *currentFlower(flower); currentFlower != topFlower; currentFlower = currentFlower->enclosingFlower) {
+		currentFlower->chainStamp = stamp;
+		currentFlower->chainOuterFlower = outerFlower;
+		currentFlower->chainPower = power;
+		power -= currentFlower->stampedPower;
+	}
+	return outerFlower;
+}
+
+EventQueue::EventQueue()
+: currentDualOffset(0)
+, flowerTable(nullptr)
+, evenFreeEdges(&Edge::queuePosition)
+, evenEvenEdges(&Edge::queuePosition)
+, oddGreenFlowers(&Flower::queuePosition)
+, scannedEdges(0)
+, refreshStamp(0)
+, threadPool(nullptr)
+{}
+
+void EventQueue::setThreadPool(ThreadPool *threadPool)
+{
+	this->threadPool = threadPool;
+}
+
+void EventQueue::clear()
+{
+	this->currentDualOffset = 0;
+	this->evenFreeEdges.clear();
+	this->evenEvenEdges.clear();
+	this->oddGreenFlowers.clear();
+	this->touchedFlowers.clear();
+}
+
+void EventQueue::initialize(const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers)
+{
+	this->clear();
+	this->flowerTable = &flowers;
+
+	// The stamped powers give the paddings at dual offset zero, which are exactly the keys of the queues.
+	this->computeEdgePaddings(edges, flowers, 0);
+
+	// Only edges whose padding shrinks with a positive epsilon are queued.
+	// The queues are sized to their edges first, as growing them by doubling could leave half of their entries unused.
+	int queuedEdgeCounts[VERTEX_PER_EDGE_COUNT + 1] = {0};
+	for (int i(0), count(edges.size()); i < count; ++i) {
+		++queuedEdgeCounts[this->slackTable.incrementableCounts[i]];
+	}
+	this->evenFreeEdges.reserve(queuedEdgeCounts[1]);
+	this->evenEvenEdges.reserve(queuedEdgeCounts[2]);
+	for (int i(0), count(edges.size()); i < count; ++i) {
+		switch (this->slackTable.incrementableCounts[i]) {
+		case 1:
+			this->evenFreeEdges.append(edges.at(i), this->slackTable.paddings[i]);
+			break;
+		case 2:
+			this->evenEvenEdges.append(edges.at(i), this->slackTable.paddings[i]);
+			break;
+		}
+	}
+	this->evenFreeEdges.heapify();
+	this->evenEvenEdges.heapify();
+}
+
+const std::vector<Flower *> &EventQueue::flowers() const
+{
+	return *this->flowerTable;
+}
+
+void EventQueue::touchFlower(Flower *flower)
+{
+	this->touchedFlowers.push_back(flower);
+}
+
+void EventQueue::removeFlower(Flower *flower)
+{
+	this->oddGreenFlowers.remove(flower);
+	this->touchedFlowers.erase(std::remove(this->touchedFlowers.begin(), this->touchedFlowers.end(), flower),
+		this->touchedFlowers.end());
+}
+
+void EventQueue::refreshTouchedFlowers()
+{
+	// No flower is nested differently during the refresh, so the stamped chains stay valid until its end.
+	int stamp(++this->refreshStamp);
+	const std::vector<Flower *> &flowers(*this->flowerTable);
+	STD_VECTOR_CONST_FOREACH_(Flower *, this->touchedFlowers, flowerIt, flowerEnd) {
+		Flower *flower(*flowerIt);
+		this->updateFlower(flower);
+		Flower *outerFlower(stampChain(flower, stamp));
+
+		for (Flower *blueFlower(flower->firstBlueFlower); blueFlower != nullptr; blueFlower = flower->nextBlueFlower(blueFlower)) {
+			stampChain(blueFlower, stamp);
+			RANGE_FOREACH_(EdgeRange, blueFlower->edges, edgeIt, edgeEnd) {
+				Edge *edge(*edgeIt);
+				Flower *oppositeBlueFlower(edge->oppositeBlueFlower(blueFlower, flowers));
+
+				// A loop crosses its blue flower twice, so it only depends on that flower.
+				if (oppositeBlueFlower == blueFlower) {
+					if (blueFlower == flower) {
+						this->updateEdge(edge);
+					}
+					continue;
+				}
+
+				// Edges within the outer flower have no incrementable flowers. They are only dropped if the touched flower
+				// has been enclosed, as the edges leaving it may have been queued before.
+				if (stampChain(oppositeBlueFlower, stamp) != outerFlower) {
+					this->updateCrossingEdge(edge, blueFlower, oppositeBlueFlower);
+				} else if (flower != outerFlower) {
+					this->removeEdge(edge);
+				}
+			}
+		}
+	}
+	this->touchedFlowers.clear();
+}
+
+void EventQueue::removeEdge(Edge *edge)
+{
+	this->evenFreeEdges.remove(edge);
+	this->evenEvenEdges.remove(edge);
+}
+
+void EventQueue::applyEpsilon(Weight epsilon)
+{
+	this->currentDualOffset += epsilon;
+}
+
+Weight EventQueue::dualOffset() const
+{
+	return this->currentDualOffset;
+}
+
+long long EventQueue::scannedEdgeCount() const
+{
+	return this->scannedEdges;
+}
+
+void EventQueue::resetScannedEdgeCount()
+{
+	this->scannedEdges = 0;
+}
+
+std::size_t EventQueue::capacityBytes() const
+{
+	return this->evenFreeEdges.capacityBytes() + this->evenEvenEdges.capacityBytes() + this->oddGreenFlowers.capacityBytes()
+		+ this->touchedFlowers.capacity() * sizeof(Flower *) + this->slackTable.capacityBytes();
+}
+
+Weight EventQueue::minEdgeEpsilon(Edge *&minEdge) const
+{
+	Weight minEpsilon(std::numeric_limits<Weight>::max());
+
+	if (!this->evenFreeEdges.empty()) {
+		minEpsilon = this->evenFreeEdges.topKey() - this->currentDualOffset;
+		minEdge = this->evenFreeEdges.top();
+	}
+
+	if (!this->evenEvenEdges.empty()) {
+		Weight weightPadding(this->evenEvenEdges.topKey() - 2 * this->currentDualOffset);
+
+#if defined(ENABLE_DEBUG_ASSERTIONS) && defined(ENABLE_INTEGER_WEIGHTS)
+		// ASSERTION: With scaled integer weights the padding of an edge between two even flowers is even.
+		if ((weightPadding % 2) != 0) {
+			std::cout << "Assertion failed: An edge between two even flowers has an odd padding." << std::endl;
+			std::exit(-1);
+		}
+#endif
+
+		Weight maxEpsilon(weightPadding / 2);
+		if (minEpsilon > maxEpsilon) {
+			minEpsilon = maxEpsilon;
+			minEdge = this->evenEvenEdges.top();
+		}
+	}
+
+	return minEpsilon;
+}
+
+Weight EventQueue::minGreenFlowerEpsilon(Flower *&minGreenFlower) const
+{
+	Weight minEpsilon(std::numeric_limits<Weight>::max());
+
+	if (!this->oddGreenFlowers.empty()) {
+		minEpsilon = this->oddGreenFlowers.topKey() - this->currentDualOffset;
+		minGreenFlower = this->oddGreenFlowers.top();
+	}
+
+	return minEpsilon;
+}
+
+void EventQueue::collectMinEdges(Weight epsilon, std::vector<Edge *> &minEdges) const
+{
+	// The epsilon is computed from the top keys in the same way as in minEdgeEpsilon, so it matches exactly.
+	if (!this->evenFreeEdges.empty() && (this->evenFreeEdges.topKey() - this->currentDualOffset == epsilon)) {
+		this->evenFreeEdges.collectTop(minEdges);
+	}
+	if (!this->evenEvenEdges.empty() && ((this->evenEvenEdges.topKey() - 2 * this->currentDualOffset) / 2 == epsilon)) {
+		this->evenEvenEdges.collectTop(minEdges);
+	}
+}
+
+void EventQueue::collectMinGreenFlowers(Weight epsilon, std::vector<Flower *> &minGreenFlowers) const
+{
+	if (!this->oddGreenFlowers.empty() && (this->oddGreenFlowers.topKey() - this->currentDualOffset == epsilon)) {
+		this->oddGreenFlowers.collectTop(minGreenFlowers);
+	}
+}
+
+Weight EventQueue::scanMinEdgeEpsilon(const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers, Edge *&minEdge)
+{
+	this->computeEdgePaddings(edges, flowers, this->currentDualOffset);
+
+	Weight minEpsilon(std::numeric_limits<Weight>::max());
+	int minEdgeIndex(-1);
+	if (!this->isParallel(edges)) {
+		minEdgeIndex = findMinEpsilonIndex(this->slackTable, minEpsilon);
+	} else {
+		// Each chunk finds its own first minimum, then the chunks are combined in order,
+		// so that the lowest edge index wins ties just as in a serial scan.
+		std::vector<Weight> chunkMinEpsilons(this->threadPool->threadCount());
+		std::vector<int> chunkMinEdgeIndices(this->threadPool->threadCount());
+		this->threadPool->run(edges.size(), [&](int chunkIndex, int begin, int end) {
+			chunkMinEdgeIndices[chunkIndex] = findMinEpsilonIndex(this->slackTable, begin, end, chunkMinEpsilons[chunkIndex]);
+		});
+		for (int i(0), count(this->threadPool->threadCount()); i < count; ++i) {
+			if ((chunkMinEdgeIndices[i] >= 0) && (chunkMinEpsilons[i] < minEpsilon)) {
+				minEpsilon = chunkMinEpsilons[i];
+				minEdgeIndex = chunkMinEdgeIndices[i];
+			}
+		}
+	}
+
+	if (minEdgeIndex >= 0) {
+		minEdge = edges.at(minEdgeIndex);
+	}
+	return minEpsilon;
+}
+
+void EventQueue::updateFlower(Flower *flower)
+{
+	if ((flower->type == Flower::Type::ODD_IN_TREE) && flower->isGreen()) {
+		this->oddGreenFlowers.push(flower, flower->stampedPower);
+	} else {
+		this->oddGreenFlowers.remove(flower);
+	}
+}
+
+void EventQueue::updateEdge(Edge *edge)
+{
+	// The stamped powers give the padding at dual offset zero, which is exactly the key of either queue.
+	int incrementableFlowerCount(0);
+	Weight weightPadding(computeEdgePadding(edge, *this->flowerTable, 0, incrementableFlowerCount));
+	this->queueEdge(edge, weightPadding, incrementableFlowerCount);
+}
+
+void EventQueue::updateCrossingEdge(Edge *edge, const Flower *blueFlowerA, const Flower *blueFlowerB)
+{
+	int incrementableFlowerCount(0);
+	Weight weightPadding(edge->weight);
+	if (!edge->isFull() && !edge->isRemoved) {
+		const Flower *outerFlowerA(blueFlowerA->chainOuterFlower);
+		const Flower *outerFlowerB(blueFlowerB->chainOuterFlower);
+		weightPadding -= blueFlowerA->chainPower + outerFlowerA->stampedPower + blueFlowerB->chainPower + outerFlowerB->stampedPower;
+		incrementableFlowerCount = dualOffsetFactor(outerFlowerA->type) + dualOffsetFactor(outerFlowerB->type);
+	}
+
+#ifdef ENABLE_DEBUG_ASSERTIONS
+	// ASSERTION: The stamped chains give the same padding as a walk through the enclosing flowers.
+	int walkedIncrementableFlowerCount(0);
+	Weight walkedWeightPadding(computeEdgePadding(edge, *this->flowerTable, 0, walkedIncrementableFlowerCount));
+	Weight difference(walkedWeightPadding - weightPadding);
+	if ((difference > 1e-6) || (difference < -1e-6) || (walkedIncrementableFlowerCount != incrementableFlowerCount)) {
+		std::cout << "Assertion failed: The stamped padding " << weightPadding << " differs from the walked padding "
+			<< walkedWeightPadding << "." << std::endl;
+		std::exit(-1);
+	}
+#endif
+
+	this->queueEdge(edge, weightPadding, incrementableFlowerCount);
+}
+
+void EventQueue::queueEdge(Edge *edge, Weight weightPadding, int incrementableFlowerCount)
+{
+	++this->scannedEdges;
+
+	// Only edges whose padding shrinks with a positive epsilon are queued.
+	// An edge that stays in its queue is rekeyed in place, which sifts it once instead of removing and inserting it.
+	switch (incrementableFlowerCount) {
+	case 1:
+		this->evenEvenEdges.remove(edge);
+		this->evenFreeEdges.push(edge, weightPadding);
+		break;
+	case 2:
+		this->evenFreeEdges.remove(edge);
+		this->evenEvenEdges.push(edge, weightPadding);
+		break;
+	default:
+		this->evenFreeEdges.remove(edge);
+		this->evenEvenEdges.remove(edge);
+		break;
+	}
+}
+
+bool EventQueue::isParallel(const IndexedPool<Edge> &edges) const
+{
+	return (this->threadPool != nullptr) && (edges.size() >= MIN_PARALLEL_EDGE_COUNT);
+}
+
+void EventQueue::computeEdgePaddings(const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers, Weight dualOffset)
+{
+	this->slackTable.resize(edges.size());
+	this->scannedEdges += static_cast<long long>(edges.size());
+
+	std::function<void(int, int, int)> computeChunk([&](int, int begin, int end) {
+		for (int i(begin); i < end; ++i) {
+			int incrementableFlowerCount(0);
+			Weight weightPadding(computeEdgePadding(edges.at(i), flowers, dualOffset, incrementableFlowerCount));
+			this->slackTable.set(i, weightPadding, incrementableFlowerCount);
+		}
+	});
+
+	if (!this->isParallel(edges)) {
+		computeChunk(0, 0, edges.size());
+	} else {
+		this->threadPool->run(edges.size(), computeChunk);
+	}
+}
\ No newline at end of file
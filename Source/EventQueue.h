@@ -0,0 +1,117 @@
+#ifndef EDMONDS_ALGORITHM_EVENT_QUEUE_H
+#define EDMONDS_ALGORITHM_EVENT_QUEUE_H
+
+#include "IndexedHeap.h"
+#include "Pool.h"
+#include "SlackKernel.h"
+#include "ThreadPool.h"
+#include "Types.h"
+
+#include <cstddef>
+#include <vector>
+
+// Keeps the regular edges that can become full in priority queues keyed by their slack
+// and the odd green flowers in a priority queue keyed by their power.
+// Keys are offset by the sum of all applied epsilon values, so a power change never requires a rekey.
+// Flowers and edges are only requeued when a flower changes type.
+class EventQueue
+{
+public:
+	EventQueue();
+
+	// Splits full scans over the threads of the pool, or runs them on the calling thread if there is no pool.
+	void setThreadPool(ThreadPool *threadPool);
+
+	// Drops all queued edges and flowers and resets the dual offset.
+	void clear();
+
+	// Queues all edges of the graph, whose blue flowers are looked up among the flowers, which are kept for the refreshes.
+	void initialize(const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers);
+
+	// Flowers among which the edges look up their blue flowers.
+	const std::vector<Flower *> &flowers() const;
+
+	// Marks a flower whose type or edges have been changed by an action.
+	void touchFlower(Flower *flower);
+
+	// Drops a flower that is about to be deleted.
+	void removeFlower(Flower *flower);
+
+	// Requeues the edges of all touched flowers.
+	void refreshTouchedFlowers();
+
+	// Requeues an edge whose weight or flowers have been changed outside of an action.
+	void updateEdge(Edge *edge);
+
+	// Drops an edge that is about to be removed from the graph.
+	void removeEdge(Edge *edge);
+
+	// Records a power change of all tree flowers.
+	void applyEpsilon(Weight epsilon);
+
+	Weight dualOffset() const;
+
+	// Number of edges whose padding has been computed since the last reset.
+	long long scannedEdgeCount() const;
+	void resetScannedEdgeCount();
+
+	// Returns the number of bytes held by the queues and the slack table.
+	std::size_t capacityBytes() const;
+
+	// Returns the epsilon value at which the first queued edge becomes full.
+	Weight minEdgeEpsilon(Edge *&minEdge) const;
+
+	// Returns the epsilon value at which the power of the first queued green flower drops to zero.
+	Weight minGreenFlowerEpsilon(Flower *&minGreenFlower) const;
+
+	// Collects all queued edges that become full at the given epsilon, which must be the min edge epsilon.
+	// Must be called before the epsilon is applied.
+	void collectMinEdges(Weight epsilon, std::vector<Edge *> &minEdges) const;
+
+	// Collects all queued green flowers whose power drops to zero at the given epsilon,
+	// which must be the min green flower epsilon. Must be called before the epsilon is applied.
+	void collectMinGreenFlowers(Weight epsilon, std::vector<Flower *> &minGreenFlowers) const;
+
+	// Returns the epsilon value at which the first of the given edges becomes full, computed by a full scan
+	// instead of the queues. Ties are broken by the lowest edge index.
+	Weight scanMinEdgeEpsilon(const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers, Edge *&minEdge);
+
+private:
+	Weight currentDualOffset;
+
+	const std::vector<Flower *> *flowerTable;
+
+	// Edges between an even tree flower and a flower in a dumbbell, keyed by slack + dual offset.
+	IndexedHeap<Edge, Weight> evenFreeEdges;
+
+	// Edges between two even tree flowers, keyed by slack + 2 * dual offset.
+	IndexedHeap<Edge, Weight> evenEvenEdges;
+
+	// Odd green flowers, keyed by power + dual offset.
+	IndexedHeap<Flower, Weight> oddGreenFlowers;
+
+	std::vector<Flower *> touchedFlowers;
+
+	long long scannedEdges;
+
+	// Stamp of the last refresh, which is never reset, as the flowers keep their stamps across solves.
+	int refreshStamp;
+
+	SlackTable slackTable;
+	ThreadPool *threadPool;
+
+	void updateFlower(Flower *flower);
+
+	// Requeues an edge between two free flowers by the chains of enclosing flowers stamped for its blue flowers.
+	void updateCrossingEdge(Edge *edge, const Flower *blueFlowerA, const Flower *blueFlowerB);
+
+	// Queues an edge by its padding at dual offset zero, if its padding shrinks with a positive epsilon.
+	void queueEdge(Edge *edge, Weight weightPadding, int incrementableFlowerCount);
+
+	// Checks whether a scan of the edges is large enough to be split between threads.
+	bool isParallel(const IndexedPool<Edge> &edges) const;
+	// Fills the slack table with the padding of every edge at the given dual offset.
+	void computeEdgePaddings(const IndexedPool<Edge> &edges, const std::vector<Flower *> &flowers, Weight dualOffset);
+};
+
+#endif // EDMONDS_ALGORITHM_EVENT_QUEUE_H
\ No newline at end of file
@@ -0,0 +1,204 @@
+#ifndef EDMONDS_ALGORITHM_INDEXED_HEAP_H
+#define EDMONDS_ALGORITHM_INDEXED_HEAP_H
+
+#include "Utility.h"
+
+#include <cstddef>
+#include <vector>
+
+// Binary min-heap of object pointers.
+// Each object stores its own position within the heap, so that it can be found, rekeyed or removed in O(log n).
+template <typename T, typename Key = double>
+class IndexedHeap
+{
+public:
+	explicit IndexedHeap(int T::*position)
+	: position(position)
+	{}
+
+	bool empty() const
+	{
+		return this->entries.empty();
+	}
+
+	int size() const
+	{
+		return static_cast<int>(this->entries.size());
+	}
+
+	T *top() const
+	{
+		return this->entries.front().item;
+	}
+
+	Key topKey() const
+	{
+		return this->entries.front().key;
+	}
+
+	bool contains(const T *item) const
+	{
+		int itemPosition(item->*(this->position));
+		return (itemPosition >= 0) && (itemPosition < this->size()) && (this->entries[itemPosition].item == item);
+	}
+
+	// Inserts the item or changes its key if it is already present.
+	void push(T *item, Key key)
+	{
+		if (this->contains(item)) {
+			int itemPosition(item->*(this->position));
+			Key oldKey(this->entries[itemPosition].key);
+			this->entries[itemPosition].key = key;
+			if (key < oldKey) {
+				this->siftUp(itemPosition);
+			} else {
+				this->siftDown(itemPosition);
+			}
+			return;
+		}
+
+		Entry entry;
+		entry.key = key;
+		entry.item = item;
+		this->entries.push_back(entry);
+		item->*(this->position) = this->size() - 1;
+		this->siftUp(this->size() - 1);
+	}
+
+	// Removes the item if it is present.
+	void remove(T *item)
+	{
+		if (!this->contains(item)) {
+			return;
+		}
+
+		int itemPosition(item->*(this->position));
+		Key removedKey(this->entries[itemPosition].key);
+		item->*(this->position) = -1;
+
+		Entry lastEntry(this->entries.back());
+		this->entries.pop_back();
+		if (itemPosition < this->size()) {
+			this->place(itemPosition, lastEntry);
+			if (lastEntry.key < removedKey) {
+				this->siftUp(itemPosition);
+			} else {
+				this->siftDown(itemPosition);
+			}
+		}
+	}
+
+	// Collects all items whose key equals the key of the top item, starting with the top item.
+	void collectTop(std::vector<T *> &items) const
+	{
+		if (this->empty()) {
+			return;
+		}
+
+		// Keys never decrease towards the leaves, so only subtrees rooted at an equal key are visited.
+		Key key(this->topKey());
+		std::vector<int> pendingPositions(1, 0);
+		while (!pendingPositions.empty()) {
+			int entryPosition(pendingPositions.back());
+			pendingPositions.pop_back();
+			items.push_back(this->entries[entryPosition].item);
+			for (int childPosition(2 * entryPosition + 2); childPosition > 2 * entryPosition; --childPosition) {
+				if ((childPosition < this->size()) && !(key < this->entries[childPosition].key)) {
+					pendingPositions.push_back(childPosition);
+				}
+			}
+		}
+	}
+
+	// Makes room for the given number of entries, so that appending them does not grow the entries past their need.
+	void reserve(int count)
+	{
+		this->entries.reserve(count);
+	}
+
+	// Appends the item without restoring the heap order, which must be followed by a call to heapify.
+	void append(T *item, Key key)
+	{
+		Entry entry;
+		entry.key = key;
+		entry.item = item;
+		this->entries.push_back(entry);
+		item->*(this->position) = this->size() - 1;
+	}
+
+	// Restores the heap order of all entries in O(n).
+	void heapify()
+	{
+		for (int entryPosition(this->size() / 2 - 1); entryPosition >= 0; --entryPosition) {
+			this->siftDown(entryPosition);
+		}
+	}
+
+	// Returns the number of bytes held by the entries.
+	std::size_t capacityBytes() const
+	{
+		return this->entries.capacity() * sizeof(Entry);
+	}
+
+	void clear()
+	{
+		for (typename std::vector<Entry>::iterator entryIt(this->entries.begin()), entryEnd(this->entries.end());
+			entryIt != entryEnd; ++entryIt) {
+			entryIt->item->*(this->position) = -1;
+		}
+		this->entries.clear();
+	}
+
+private:
+	struct Entry
+	{
+		Key key;
+		T *item;
+	};
+
+	std::vector<Entry> entries;
+	int T::*position;
+
+	void place(int entryPosition, const Entry &entry)
+	{
+		this->entries[entryPosition] = entry;
+		entry.item->*(this->position) = entryPosition;
+	}
+
+	void siftUp(int entryPosition)
+	{
+		Entry entry(this->entries[entryPosition]);
+		while (entryPosition > 0) {
+			int parentPosition((entryPosition - 1) / 2);
+			if (!(entry.key < this->entries[parentPosition].key)) {
+				break;
+			}
+			this->place(entryPosition, this->entries[parentPosition]);
+			entryPosition = parentPosition;
+		}
+		this->place(entryPosition, entry);
+	}
+
+	void siftDown(int entryPosition)
+	{
+		Entry entry(this->entries[entryPosition]);
+		int count(this->size());
+		FOREVER {
+			int childPosition(2 * entryPosition + 1);
+			if (childPosition >= count) {
+				break;
+			}
+			if ((childPosition + 1 < count) && (this->entries[childPosition + 1].key < this->entries[childPosition].key)) {
+				++childPosition;
+			}
+			if (!(this->entries[childPosition].key < entry.key)) {
+				break;
+			}
+			this->place(entryPosition, this->entries[childPosition]);
+			entryPosition = childPosition;
+		}
+		this->place(entryPosition, entry);
+	}
+};
+
+#endif // EDMONDS_ALGORITHM_INDEXED_HEAP_H
\ No newline at end of file
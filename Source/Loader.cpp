@@ -0,0 +1,730 @@
+#include "Loader.h"
+
+#include "Utility.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const char BINARY_MAGIC[4] = { 'E', 'D', 'M', 'B' };
+const std::int32_t BINARY_VERSION = 1;
+
+static_assert(sizeof(InputEdge) == 16, "Binary edge records are expected to take 16 bytes.");
+
+// Header of the binary format, which is followed by the edge records.
+struct BinaryHeader
+{
+	char magic[4];
+	std::int32_t version;
+	std::int32_t vertexCount;
+	std::int32_t edgeCount;
+};
+
+// Whole input in memory, either mapped from a file or read from the standard input.
+class InputBuffer
+{
+public:
+	InputBuffer()
+	: mappedData(nullptr)
+	, mappedSize(0)
+#ifdef _WIN32
+	, fileHandle(INVALID_HANDLE_VALUE)
+	, mappingHandle(nullptr)
+#endif
+	{}
+
+	~InputBuffer()
+	{
+#ifdef _WIN32
+		if (this->mappedData != nullptr) {
+			UnmapViewOfFile(this->mappedData);
+		}
+		if (this->mappingHandle != nullptr) {
+			CloseHandle(this->mappingHandle);
+		}
+		if (this->fileHandle != INVALID_HANDLE_VALUE) {
+			CloseHandle(this->fileHandle);
+		}
+#else
+		if (this->mappedData != nullptr) {
+			munmap(const_cast<char *>(this->mappedData), this->mappedSize);
+		}
+#endif
+	}
+
+	bool mapFile(const char *path)
+	{
+#ifdef _WIN32
+		this->fileHandle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (this->fileHandle == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(this->fileHandle, &fileSize)) {
+			return false;
+		}
+		this->mappedSize = static_cast<size_t>(fileSize.QuadPart);
+		if (this->mappedSize == 0) {
+			return true;
+		}
+		this->mappingHandle = CreateFileMappingA(this->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (this->mappingHandle == nullptr) {
+			return false;
+		}
+		this->mappedData = static_cast<const char *>(MapViewOfFile(this->mappingHandle, FILE_MAP_READ, 0, 0, 0));
+		return this->mappedData != nullptr;
+#else
+		int fileDescriptor(open(path, O_RDONLY));
+		if (fileDescriptor < 0) {
+			return false;
+		}
+		struct stat fileStatus;
+		if (fstat(fileDescriptor, &fileStatus) != 0) {
+			close(fileDescriptor);
+			return false;
+		}
+		this->mappedSize = static_cast<size_t>(fileStatus.st_size);
+		if (this->mappedSize == 0) {
+			close(fileDescriptor);
+			return true;
+		}
+		void *mapping(mmap(nullptr, this->mappedSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0));
+		close(fileDescriptor);
+		if (mapping == MAP_FAILED) {
+			this->mappedSize = 0;
+			return false;
+		}
+		madvise(mapping, this->mappedSize, MADV_SEQUENTIAL);
+		this->mappedData = static_cast<const char *>(mapping);
+		return true;
+#endif
+	}
+
+	void readStandardInput()
+	{
+		char chunk[1 << 16];
+		size_t chunkSize(0);
+		while ((chunkSize = std::fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+			this->readData.insert(this->readData.end(), chunk, chunk + chunkSize);
+		}
+	}
+
+	const char *begin() const
+	{
+		return (this->mappedData != nullptr) ? this->mappedData : this->readData.data();
+	}
+
+	const char *end() const
+	{
+		return this->begin() + ((this->mappedData != nullptr) ? this->mappedSize : this->readData.size());
+	}
+
+private:
+	const char *mappedData;
+	size_t mappedSize;
+	std::vector<char> readData;
+#ifdef _WIN32
+	HANDLE fileHandle;
+	HANDLE mappingHandle;
+#endif
+};
+
+// Reads whitespace separated numbers and words without any locale handling.
+class TextScanner
+{
+public:
+	TextScanner(const char *begin, const char *end)
+	: current(begin)
+	, last(end)
+	{}
+
+	bool atEnd()
+	{
+		this->skipSpace();
+		return this->current == this->last;
+	}
+
+	char peek()
+	{
+		this->skipSpace();
+		return (this->current != this->last) ? *this->current : '\0';
+	}
+
+	void skipLine()
+	{
+		while ((this->current != this->last) && (*this->current != '\n')) {
+			++this->current;
+		}
+	}
+
+	// Reads a word ending at whitespace or at the given delimiter.
+	bool readWord(const char *&word, int &wordLength, char delimiter = '\0')
+	{
+		this->skipSpace();
+		word = this->current;
+		while ((this->current != this->last) && !isSpace(*this->current) && (*this->current != delimiter)) {
+			++this->current;
+		}
+		wordLength = static_cast<int>(this->current - word);
+		return wordLength > 0;
+	}
+
+	// Skips the delimiter if it is the next character on the current line.
+	void skipDelimiter(char delimiter)
+	{
+		while ((this->current != this->last) && ((*this->current == ' ') || (*this->current == '\t'))) {
+			++this->current;
+		}
+		if ((this->current != this->last) && (*this->current == delimiter)) {
+			++this->current;
+		}
+	}
+
+	bool readInt(int &value)
+	{
+		this->skipSpace();
+		bool isNegative(this->readSign());
+		if ((this->current == this->last) || !isDigit(*this->current)) {
+			return false;
+		}
+		long long result(0);
+		while ((this->current != this->last) && isDigit(*this->current)) {
+			result = result * 10 + (*this->current - '0');
+			++this->current;
+		}
+		value = static_cast<int>(isNegative ? -result : result);
+		return true;
+	}
+
+	bool readDouble(double &value)
+	{
+		this->skipSpace();
+		const char *start(this->current);
+		bool isNegative(this->readSign());
+
+		// Collect up to 19 significant digits, which fit into the mantissa without overflow.
+		unsigned long long mantissa(0);
+		int digitCount(0);
+		int exponent(0);
+		bool hasDigits(false);
+		while ((this->current != this->last) && isDigit(*this->current)) {
+			if (digitCount < 19) {
+				mantissa = mantissa * 10 + (*this->current - '0');
+				digitCount += (mantissa != 0) ? 1 : 0;
+			} else {
+				++exponent;
+			}
+			hasDigits = true;
+			++this->current;
+		}
+		if ((this->current != this->last) && (*this->current == '.')) {
+			++this->current;
+			while ((this->current != this->last) && isDigit(*this->current)) {
+				if (digitCount < 19) {
+					mantissa = mantissa * 10 + (*this->current - '0');
+					digitCount += (mantissa != 0) ? 1 : 0;
+					--exponent;
+				}
+				hasDigits = true;
+				++this->current;
+			}
+		}
+		if (!hasDigits) {
+			return false;
+		}
+		if ((this->current != this->last) && ((*this->current == 'e') || (*this->current == 'E'))) {
+			++this->current;
+			int explicitExponent(0);
+			if (!this->readInt(explicitExponent)) {
+				return false;
+			}
+			exponent += explicitExponent;
+		}
+
+		// Powers of ten up to 1e22 and mantissas up to 2^53 are exact, so a single rounding gives the exact result.
+		static const double POWERS_OF_TEN[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+		if ((mantissa < (1ull << 53)) && (exponent >= -22) && (exponent <= 22)) {
+			value = static_cast<double>(mantissa);
+			value = (exponent < 0) ? value / POWERS_OF_TEN[-exponent] : value * POWERS_OF_TEN[exponent];
+			if (isNegative) {
+				value = -value;
+			}
+			return true;
+		}
+
+		// Leave the rare long or extreme values to the standard library.
+		std::string token(start, this->current);
+		value = std::strtod(token.c_str(), nullptr);
+		return true;
+	}
+
+private:
+	const char *current;
+	const char *last;
+
+	static bool isSpace(char character)
+	{
+		return (character == ' ') || (character == '\t') || (character == '\n') || (character == '\r')
+			|| (character == '\f') || (character == '\v');
+	}
+
+	static bool isDigit(char character)
+	{
+		return (character >= '0') && (character <= '9');
+	}
+
+	void skipSpace()
+	{
+		while ((this->current != this->last) && isSpace(*this->current)) {
+			++this->current;
+		}
+	}
+
+	bool readSign()
+	{
+		if ((this->current != this->last) && ((*this->current == '-') || (*this->current == '+'))) {
+			return *this->current++ == '-';
+		}
+		return false;
+	}
+};
+
+bool isWord(const char *word, int wordLength, const char *expected)
+{
+	return (static_cast<int>(std::strlen(expected)) == wordLength) && (std::strncmp(word, expected, wordLength) == 0);
+}
+
+bool addEdge(InputGraph &graph, int vertexIdA, int vertexIdB, double weight)
+{
+	if ((vertexIdA < 1) || (vertexIdA > graph.vertexCount) || (vertexIdB < 1) || (vertexIdB > graph.vertexCount)) {
+		return false;
+	}
+	InputEdge edge;
+	edge.vertexIds[0] = vertexIdA;
+	edge.vertexIds[1] = vertexIdB;
+	edge.weight = weight;
+	graph.edges.push_back(edge);
+	return true;
+}
+
+bool parseText(const InputBuffer &input, InputGraph &graph, const char *&errorMessage)
+{
+	TextScanner scanner(input.begin(), input.end());
+
+	int edgeCount(0);
+	if (!scanner.readInt(graph.vertexCount) || !scanner.readInt(edgeCount) || (graph.vertexCount < 0) || (edgeCount < 0)) {
+		errorMessage = "The vertex and edge counts are missing.";
+		return false;
+	}
+
+	graph.edges.reserve(edgeCount);
+	for (int i(0); i < edgeCount; ++i) {
+		int vertexIdA(0);
+		int vertexIdB(0);
+		double weight(0.0);
+		if (!scanner.readInt(vertexIdA) || !scanner.readInt(vertexIdB) || !scanner.readDouble(weight)) {
+			errorMessage = "An edge is incomplete.";
+			return false;
+		}
+		if (!addEdge(graph, vertexIdA, vertexIdB, weight)) {
+			errorMessage = "An edge references a vertex that does not exist.";
+			return false;
+		}
+	}
+	return true;
+}
+
+bool parseDimacs(const InputBuffer &input, InputGraph &graph, const char *&errorMessage)
+{
+	TextScanner scanner(input.begin(), input.end());
+
+	bool hasProblemLine(false);
+	while (!scanner.atEnd()) {
+		const char *word(nullptr);
+		int wordLength(0);
+		scanner.readWord(word, wordLength);
+
+		if (isWord(word, wordLength, "p")) {
+			// The problem line names the problem type, then gives the vertex and edge counts.
+			int edgeCount(0);
+			if (!scanner.readWord(word, wordLength) || !scanner.readInt(graph.vertexCount) || !scanner.readInt(edgeCount)
+				|| (graph.vertexCount < 0) || (edgeCount < 0)) {
+				errorMessage = "The DIMACS problem line is malformed.";
+				return false;
+			}
+			graph.edges.reserve(edgeCount);
+			hasProblemLine = true;
+		} else if (isWord(word, wordLength, "e") || isWord(word, wordLength, "a")) {
+			int vertexIdA(0);
+			int vertexIdB(0);
+			if (!hasProblemLine || !scanner.readInt(vertexIdA) || !scanner.readInt(vertexIdB)) {
+				errorMessage = "A DIMACS edge line is malformed.";
+				return false;
+			}
+
+			// Edges without a weight have unit weight.
+			double weight(1.0);
+			char next(scanner.peek());
+			if ((next == '-') || (next == '+') || (next == '.') || ((next >= '0') && (next <= '9'))) {
+				scanner.readDouble(weight);
+			}
+			if (!addEdge(graph, vertexIdA, vertexIdB, weight)) {
+				errorMessage = "A DIMACS edge references a vertex that does not exist.";
+				return false;
+			}
+		}
+
+		// Comments and unknown lines are ignored.
+		scanner.skipLine();
+	}
+
+	if (!hasProblemLine) {
+		errorMessage = "The DIMACS problem line is missing.";
+		return false;
+	}
+	return true;
+}
+
+// Rounds to the nearest integer as required by TSPLIB.
+double nint(double value)
+{
+	return static_cast<double>(static_cast<long long>(value + 0.5));
+}
+
+double geoRadians(double coordinate)
+{
+	const double PI(3.141592);
+	double degrees(static_cast<double>(static_cast<long long>(coordinate)));
+	return PI * (degrees + 5.0 * (coordinate - degrees) / 3.0) / 180.0;
+}
+
+bool parseCoordinateMetric(const char *weightType, int weightTypeLength, CoordinateMetric &metric)
+{
+	if (isWord(weightType, weightTypeLength, "EUC_2D")) {
+		metric = CoordinateMetric::EUC_2D;
+	} else if (isWord(weightType, weightTypeLength, "CEIL_2D")) {
+		metric = CoordinateMetric::CEIL_2D;
+	} else if (isWord(weightType, weightTypeLength, "ATT")) {
+		metric = CoordinateMetric::ATT;
+	} else if (isWord(weightType, weightTypeLength, "MAN_2D")) {
+		metric = CoordinateMetric::MAN_2D;
+	} else if (isWord(weightType, weightTypeLength, "MAX_2D")) {
+		metric = CoordinateMetric::MAX_2D;
+	} else if (isWord(weightType, weightTypeLength, "GEO")) {
+		metric = CoordinateMetric::GEO;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+double computeCoordinateWeight(CoordinateMetric metric, const double *coordinatesA, const double *coordinatesB)
+{
+	double dx(coordinatesA[0] - coordinatesB[0]);
+	double dy(coordinatesA[1] - coordinatesB[1]);
+
+	double weight(0.0);
+	if (metric == CoordinateMetric::EUC_2D) {
+		weight = nint(std::sqrt(dx * dx + dy * dy));
+	} else if (metric == CoordinateMetric::CEIL_2D) {
+		weight = std::ceil(std::sqrt(dx * dx + dy * dy));
+	} else if (metric == CoordinateMetric::ATT) {
+		double distance(std::sqrt((dx * dx + dy * dy) / 10.0));
+		weight = nint(distance);
+		if (weight < distance) {
+			weight += 1.0;
+		}
+	} else if (metric == CoordinateMetric::MAN_2D) {
+		weight = nint(std::fabs(dx) + std::fabs(dy));
+	} else if (metric == CoordinateMetric::MAX_2D) {
+		weight = std::fmax(nint(std::fabs(dx)), nint(std::fabs(dy)));
+	} else if (metric == CoordinateMetric::GEO) {
+		const double EARTH_RADIUS(6378.388);
+		double latitudeA(geoRadians(coordinatesA[0]));
+		double longitudeA(geoRadians(coordinatesA[1]));
+		double latitudeB(geoRadians(coordinatesB[0]));
+		double longitudeB(geoRadians(coordinatesB[1]));
+		double q1(std::cos(longitudeA - longitudeB));
+		double q2(std::cos(latitudeA - latitudeB));
+		double q3(std::cos(latitudeA + latitudeB));
+		weight = static_cast<double>(static_cast<long long>(
+			EARTH_RADIUS * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0));
+	}
+	return weight;
+}
+
+bool parseTsplib(const InputBuffer &input, bool isImplicitAllowed, InputGraph &graph, const char *&errorMessage)
+{
+	TextScanner scanner(input.begin(), input.end());
+
+	const char *weightType("EUC_2D");
+	int weightTypeLength(6);
+	const char *weightFormat("FULL_MATRIX");
+	int weightFormatLength(11);
+	graph.vertexCount = -1;
+
+	while (!scanner.atEnd()) {
+		const char *key(nullptr);
+		int keyLength(0);
+		scanner.readWord(key, keyLength, ':');
+		scanner.skipDelimiter(':');
+
+		if (isWord(key, keyLength, "DIMENSION")) {
+			if (!scanner.readInt(graph.vertexCount) || (graph.vertexCount < 0)) {
+				errorMessage = "The TSPLIB dimension is malformed.";
+				return false;
+			}
+		} else if (isWord(key, keyLength, "EDGE_WEIGHT_TYPE")) {
+			scanner.readWord(weightType, weightTypeLength);
+		} else if (isWord(key, keyLength, "EDGE_WEIGHT_FORMAT")) {
+			scanner.readWord(weightFormat, weightFormatLength);
+		} else if (isWord(key, keyLength, "NODE_COORD_SECTION")) {
+			if (graph.vertexCount < 0) {
+				errorMessage = "The TSPLIB dimension is missing.";
+				return false;
+			}
+
+			CoordinateMetric metric(CoordinateMetric::NONE);
+			if (!parseCoordinateMetric(weightType, weightTypeLength, metric)) {
+				errorMessage = "The TSPLIB edge weight type is not supported.";
+				return false;
+			}
+
+			std::vector<double> coordinates(2 * static_cast<size_t>(graph.vertexCount));
+			for (int i(0); i < graph.vertexCount; ++i) {
+				int vertexId(0);
+				double x(0.0);
+				double y(0.0);
+				if (!scanner.readInt(vertexId) || !scanner.readDouble(x) || !scanner.readDouble(y)
+					|| (vertexId < 1) || (vertexId > graph.vertexCount)) {
+					errorMessage = "A TSPLIB node coordinate line is malformed.";
+					return false;
+				}
+				coordinates[2 * (vertexId - 1)] = x;
+				coordinates[2 * (vertexId - 1) + 1] = y;
+			}
+
+			// The instance is a complete graph, whose edges are only listed if it cannot stay implicit.
+			if (isImplicitAllowed) {
+				graph.metric = metric;
+				graph.coordinates.swap(coordinates);
+				return true;
+			}
+			graph.edges.reserve(static_cast<size_t>(graph.vertexCount) * (graph.vertexCount - 1) / 2);
+			for (int i(0); i < graph.vertexCount; ++i) {
+				for (int j(i + 1); j < graph.vertexCount; ++j) {
+					addEdge(graph, i + 1, j + 1, computeCoordinateWeight(metric, &coordinates[2 * i], &coordinates[2 * j]));
+				}
+			}
+			return true;
+		} else if (isWord(key, keyLength, "EDGE_WEIGHT_SECTION")) {
+			if (graph.vertexCount < 0) {
+				errorMessage = "The TSPLIB dimension is missing.";
+				return false;
+			}
+
+			// Each format lists the matrix entries row by row, restricted to some of the columns.
+			bool isFull(isWord(weightFormat, weightFormatLength, "FULL_MATRIX"));
+			bool isUpper(isWord(weightFormat, weightFormatLength, "UPPER_ROW")
+				|| isWord(weightFormat, weightFormatLength, "UPPER_DIAG_ROW"));
+			bool isLower(isWord(weightFormat, weightFormatLength, "LOWER_ROW")
+				|| isWord(weightFormat, weightFormatLength, "LOWER_DIAG_ROW"));
+			bool hasDiagonal(isFull || isWord(weightFormat, weightFormatLength, "UPPER_DIAG_ROW")
+				|| isWord(weightFormat, weightFormatLength, "LOWER_DIAG_ROW"));
+			if (!isFull && !isUpper && !isLower) {
+				errorMessage = "The TSPLIB edge weight format is not supported.";
+				return false;
+			}
+
+			graph.edges.reserve(static_cast<size_t>(graph.vertexCount) * (graph.vertexCount - 1) / 2);
+			for (int i(0); i < graph.vertexCount; ++i) {
+				int firstColumn(isUpper ? (hasDiagonal ? i : i + 1) : 0);
+				int lastColumn(isLower ? (hasDiagonal ? i : i - 1) : graph.vertexCount - 1);
+				for (int j(firstColumn); j <= lastColumn; ++j) {
+					double weight(0.0);
+					if (!scanner.readDouble(weight)) {
+						errorMessage = "The TSPLIB edge weight section is incomplete.";
+						return false;
+					}
+					if (isFull ? (i < j) : (i != j)) {
+						addEdge(graph, i + 1, j + 1, weight);
+					}
+				}
+			}
+			return true;
+		} else if (isWord(key, keyLength, "EOF")) {
+			break;
+		}
+
+		// Other specification entries are not needed.
+		scanner.skipLine();
+	}
+
+	errorMessage = "The TSPLIB instance has no node coordinate or edge weight section.";
+	return false;
+}
+
+bool parseBinary(const InputBuffer &input, InputGraph &graph, const char *&errorMessage)
+{
+	size_t inputSize(static_cast<size_t>(input.end() - input.begin()));
+
+	BinaryHeader header;
+	if (inputSize < sizeof(header)) {
+		errorMessage = "The binary header is incomplete.";
+		return false;
+	}
+	std::memcpy(&header, input.begin(), sizeof(header));
+	if ((std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) || (header.version != BINARY_VERSION)
+		|| (header.vertexCount < 0) || (header.edgeCount < 0)) {
+		errorMessage = "The binary header is malformed.";
+		return false;
+	}
+	if ((inputSize - sizeof(header)) / sizeof(InputEdge) < static_cast<size_t>(header.edgeCount)) {
+		errorMessage = "The binary edge records are incomplete.";
+		return false;
+	}
+
+	// The records are copied as a whole, there is nothing to parse.
+	graph.vertexCount = header.vertexCount;
+	graph.edges.resize(header.edgeCount);
+	if (header.edgeCount > 0) {
+		std::memcpy(graph.edges.data(), input.begin() + sizeof(header), header.edgeCount * sizeof(InputEdge));
+	}
+
+	STD_VECTOR_CONST_FOREACH_(InputEdge, graph.edges, edgeIt, edgeEnd) {
+		for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			if ((edgeIt->vertexIds[i] < 1) || (edgeIt->vertexIds[i] > graph.vertexCount)) {
+				errorMessage = "A binary edge references a vertex that does not exist.";
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+InputFormat detectInputFormat(const InputBuffer &input)
+{
+	if ((input.end() - input.begin() >= static_cast<long long>(sizeof(BINARY_MAGIC)))
+		&& (std::memcmp(input.begin(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0)) {
+		return InputFormat::BINARY;
+	}
+
+	TextScanner scanner(input.begin(), input.end());
+	char first(scanner.peek());
+	if (((first >= '0') && (first <= '9')) || (first == '\0')) {
+		return InputFormat::TEXT;
+	}
+
+	const char *word(nullptr);
+	int wordLength(0);
+	scanner.readWord(word, wordLength);
+	if (isWord(word, wordLength, "c") || isWord(word, wordLength, "p")) {
+		return InputFormat::DIMACS;
+	}
+	return InputFormat::TSPLIB;
+}
+
+InputGraph::InputGraph()
+: vertexCount(0)
+, metric(CoordinateMetric::NONE)
+{}
+
+bool InputGraph::isImplicit() const
+{
+	return this->metric != CoordinateMetric::NONE;
+}
+
+double InputGraph::implicitWeight(int vertexA, int vertexB) const
+{
+	return computeCoordinateWeight(this->metric, &this->coordinates[2 * vertexA], &this->coordinates[2 * vertexB]);
+}
+
+bool parseInputFormat(const char *name, InputFormat &format)
+{
+	int nameLength(static_cast<int>(std::strlen(name)));
+	if (isWord(name, nameLength, "auto")) {
+		format = InputFormat::AUTO;
+	} else if (isWord(name, nameLength, "text")) {
+		format = InputFormat::TEXT;
+	} else if (isWord(name, nameLength, "tsplib")) {
+		format = InputFormat::TSPLIB;
+	} else if (isWord(name, nameLength, "dimacs")) {
+		format = InputFormat::DIMACS;
+	} else if (isWord(name, nameLength, "binary")) {
+		format = InputFormat::BINARY;
+	} else {
+		return false;
+	}
+	return true;
+}
+
+bool loadGraph(const char *path, InputFormat format, bool isImplicitAllowed, InputGraph &graph,
+	const char *&errorMessage)
+{
+	graph.vertexCount = 0;
+	graph.edges.clear();
+	graph.metric = CoordinateMetric::NONE;
+	graph.coordinates.clear();
+
+	InputBuffer input;
+	if (path == nullptr) {
+		input.readStandardInput();
+	} else if (!input.mapFile(path)) {
+		errorMessage = "The input file could not be opened.";
+		return false;
+	}
+
+	if (format == InputFormat::AUTO) {
+		format = detectInputFormat(input);
+	}
+
+	switch (format) {
+	case InputFormat::TSPLIB:
+		return parseTsplib(input, isImplicitAllowed, graph, errorMessage);
+	case InputFormat::DIMACS:
+		return parseDimacs(input, graph, errorMessage);
+	case InputFormat::BINARY:
+		return parseBinary(input, graph, errorMessage);
+	default:
+		return parseText(input, graph, errorMessage);
+	}
+}
+
+bool saveBinaryGraph(const char *path, const InputGraph &graph)
+{
+	std::FILE *file(std::fopen(path, "wb"));
+	if (file == nullptr) {
+		return false;
+	}
+
+	BinaryHeader header;
+	std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+	header.version = BINARY_VERSION;
+	header.vertexCount = graph.vertexCount;
+	header.edgeCount = static_cast<std::int32_t>(graph.edges.size());
+
+	bool isWritten(std::fwrite(&header, sizeof(header), 1, file) == 1);
+	if (isWritten && !graph.edges.empty()) {
+		isWritten = std::fwrite(graph.edges.data(), sizeof(InputEdge), graph.edges.size(), file) == graph.edges.size();
+	}
+	return (std::fclose(file) == 0) && isWritten;
+}
\ No newline at end of file
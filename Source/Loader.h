@@ -0,0 +1,74 @@
+#ifndef EDMONDS_ALGORITHM_LOADER_H
+#define EDMONDS_ALGORITHM_LOADER_H
+
+#include "Utility.h"
+
+#include <vector>
+
+// Edge as read from the input, with vertex ids starting at one.
+// The layout matches a record of the binary format.
+struct InputEdge
+{
+	int vertexIds[VERTEX_PER_EDGE_COUNT];
+	double weight;
+};
+
+// Metrics of TSPLIB instances given by node coordinates.
+enum class CoordinateMetric : char
+{
+	// The edges are listed instead.
+	NONE,
+	EUC_2D,
+	CEIL_2D,
+	ATT,
+	MAN_2D,
+	MAX_2D,
+	GEO
+};
+
+// Graph as read from the input, before any flowers or edges are created.
+// An implicit complete graph stores the coordinates of its vertices instead of its edges.
+struct InputGraph
+{
+	int vertexCount;
+	std::vector<InputEdge> edges;
+	CoordinateMetric metric;
+	// Two coordinates of each vertex of an implicit complete graph.
+	std::vector<double> coordinates;
+
+	InputGraph();
+
+	bool isImplicit() const;
+
+	// Weight of the edge between two vertices of an implicit complete graph, counted from zero.
+	double implicitWeight(int vertexA, int vertexB) const;
+};
+
+enum class InputFormat : char
+{
+	// Detects the format from the beginning of the input.
+	AUTO,
+	// The vertex count, the edge count and then a vertex id pair and a weight for each edge.
+	TEXT,
+	// A TSPLIB instance, converted into a complete graph.
+	TSPLIB,
+	// A DIMACS graph with "p" and "e" lines.
+	DIMACS,
+	// A header followed by the edges stored as raw InputEdge records.
+	BINARY
+};
+
+// Parses the format name used on the command line.
+bool parseInputFormat(const char *name, InputFormat &format);
+
+// Reads a graph from the file, or from the standard input if no path is given.
+// TSPLIB instances with node coordinates are only loaded as implicit complete graphs if isImplicitAllowed is set.
+// On failure an error message is stored and false is returned.
+bool loadGraph(const char *path, InputFormat format, bool isImplicitAllowed, InputGraph &graph,
+	const char *&errorMessage);
+
+// Writes the graph in the binary format, so that it can be loaded without parsing.
+// The graph must not be implicit.
+bool saveBinaryGraph(const char *path, const InputGraph &graph);
+
+#endif // EDMONDS_ALGORITHM_LOADER_H
\ No newline at end of file
@@ -1,213 +1,302 @@
-#include "Actions.h"
-#include "Evaluation.h"
-#include "Types.h"
+#include "Assignment.h"
+#include "Batch.h"
+#include "Components.h"
+#include "Loader.h"
+#include "MatchingSolver.h"
+#include "Pricing.h"
+#include "Statistics.h"
 #include "Utility.h"
 
-#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <utility>
 #include <vector>
 
-bool testOneIsDumbbell(const std::vector<Flower *> &flowers)
+// The signal that makes a running solve write its statistics to the standard error output.
+#ifdef SIGUSR1
+#define STATISTICS_DUMP_SIGNAL SIGUSR1
+#else
+#define STATISTICS_DUMP_SIGNAL SIGBREAK
+#endif
+
+extern "C" void handleStatisticsDumpSignal(int)
 {
-	for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
-		if (flowers[i]->isInDumbbell()) {
-			return true;
-		}
+	requestStatisticsDump();
+	std::signal(STATISTICS_DUMP_SIGNAL, handleStatisticsDumpSignal);
+}
+
+// Engines that can solve the loaded graph.
+enum class Engine : char
+{
+	// The assignment engine for bipartite graphs, the flowers otherwise.
+	AUTO,
+	EDMONDS,
+	ASSIGNMENT
+};
+
+void printUsage()
+{
+	std::cerr << "Usage: EdmondsAlgorithm [--format auto|text|tsplib|dimacs|binary] [--convert OUTPUT] [--engine auto|edmonds|assignment] [--threads COUNT] [--no-warm-start] [--pricing COUNT] [--statistics OUTPUT] [INPUT]" << std::endl
+		<< "       EdmondsAlgorithm --batch MANIFEST|DIRECTORY [--format ...] [--threads COUNT] [--no-warm-start] [--pricing COUNT]" << std::endl
+		<< "Reads the graph from INPUT, or from the standard input if no INPUT is given." << std::endl
+		<< "With --batch every file listed in MANIFEST or found in DIRECTORY is solved, COUNT files at a time," << std::endl
+		<< "and one JSON object per file is written in the order of the files, followed by the throughput on the error output." << std::endl
+		<< "With --convert the graph is only written to OUTPUT in the binary format." << std::endl
+		<< "Bipartite graphs are solved by the assignment engine without flowers, unless --engine says otherwise." << std::endl
+		<< "With --threads COUNT connected components are solved at a time if the graph has several of them." << std::endl
+		<< "A connected graph only splits the padding computation of its initial edge queue between COUNT threads." << std::endl
+		<< "The search begins from a greedy pairing, or from an empty one with --no-warm-start." << std::endl
+		<< "With --pricing the graph is solved on the COUNT lightest edges of each vertex first," << std::endl
+		<< "and the other edges are only added if the powers found for the pairing require them." << std::endl
+		<< "TSPLIB node coordinates are then kept instead of the edges of the complete graph." << std::endl
+		<< "With --statistics the phase times, the counters and the bytes per edge of the solve are written to OUTPUT as JSON." << std::endl
+		<< "The counters of a running solve are written to the standard error output on SIGUSR1 (SIGBREAK on Windows)." << std::endl;
+}
+
+template <typename Statistics>
+bool writeStatistics(const char *statisticsPath, const Statistics &statistics)
+{
+	std::ofstream statisticsStream(statisticsPath);
+	statistics.writeJson(statisticsStream);
+	statisticsStream << std::endl;
+	if (!statisticsStream) {
+		std::cerr << "Error: The statistics could not be written." << std::endl;
+		return false;
 	}
-	return false;
+	return true;
 }
 
-bool testAllRootEquality(const std::vector<Flower *> &flowers)
+// Writes the vertices of a paired edge on one line.
+void printPairingEdge(const InputEdge &edge)
 {
-	const Flower *root(flowers[0]->root());
+	std::cout << edge.vertexIds[0];
 	for (int i(1); i < VERTEX_PER_EDGE_COUNT; ++i) {
-		if (root != flowers[i]->root()) {
-			return false;
-		}
+		std::cout << " " << edge.vertexIds[i];
 	}
-	return true;
+	std::cout << std::endl;
 }
 
 int main(const int argc, const char *argv[])
 {
 	std::cout << std::fixed << std::setprecision(2);
 
-	// Read input.
-	int vertexCount(0);
-	int edgeCount(0);
-	std::cin >> vertexCount;
-	std::cin >> edgeCount;
-	
-	// Initialize Blue Flowers.
-	std::vector<Flower *> flowers(vertexCount);
-	for (int i(0); i < vertexCount; ++i) {
-		Flower *&flower(flowers[i]);
-		flower = new Flower();
-		flower->vertexId = i + 1;
-	}
-
-	// Initialize Edges.
-	std::vector<Edge *> edges(edgeCount);
-	STD_VECTOR_FOREACH_(Edge *, edges, edgeIt, edgeEnd) {
-		*edgeIt = new Edge();
-		Edge *edge(*edgeIt);		
-
-		for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
-			int vertexId(0);
-			std::cin >> vertexId;
-
-			Flower *blueFlower(flowers[vertexId - 1]);
-			blueFlower->edges.push_back(edge);
-			edge->flowers.push_back(blueFlower);
-			edge->blueFlowers.push_back(blueFlower);
+	// Parse arguments.
+	const char *inputPath(nullptr);
+	const char *convertPath(nullptr);
+	const char *statisticsPath(nullptr);
+	const char *batchPath(nullptr);
+	InputFormat inputFormat(InputFormat::AUTO);
+	Engine engine(Engine::AUTO);
+	int threadCount(1);
+	bool isWarmStartEnabled(true);
+	int candidateCount(0);
+	for (int i(1); i < argc; ++i) {
+		std::string argument(argv[i]);
+		if ((argument == "--format") && (i + 1 < argc)) {
+			if (!parseInputFormat(argv[++i], inputFormat)) {
+				printUsage();
+				return 1;
+			}
+		} else if ((argument == "--engine") && (i + 1 < argc)) {
+			std::string engineName(argv[++i]);
+			if (engineName == "auto") {
+				engine = Engine::AUTO;
+			} else if (engineName == "edmonds") {
+				engine = Engine::EDMONDS;
+			} else if (engineName == "assignment") {
+				engine = Engine::ASSIGNMENT;
+			} else {
+				printUsage();
+				return 1;
+			}
+		} else if ((argument == "--convert") && (i + 1 < argc)) {
+			convertPath = argv[++i];
+		} else if ((argument == "--threads") && (i + 1 < argc)) {
+			threadCount = std::atoi(argv[++i]);
+			if (threadCount < 1) {
+				printUsage();
+				return 1;
+			}
+		} else if ((argument == "--batch") && (i + 1 < argc)) {
+			batchPath = argv[++i];
+		} else if ((argument == "--statistics") && (i + 1 < argc)) {
+			statisticsPath = argv[++i];
+		} else if ((argument == "--pricing") && (i + 1 < argc)) {
+			candidateCount = std::atoi(argv[++i]);
+			if (candidateCount < 1) {
+				printUsage();
+				return 1;
+			}
+		} else if (argument == "--warm-start") {
+			// Kept for the scripts written while the warm start was optional.
+			isWarmStartEnabled = true;
+		} else if (argument == "--no-warm-start") {
+			isWarmStartEnabled = false;
+		} else if ((inputPath == nullptr) && (argument.compare(0, 2, "--") != 0)) {
+			inputPath = argv[i];
+		} else {
+			printUsage();
+			return 1;
 		}
-		
-		std::cin >> edge->weight;
 	}
 
-	// Core algorithm loop.
-	int pairingEdgeCount(0);
-	FOREVER {
-		// Find the min epsilon.
-		Edge *minEdge(nullptr);
-		double minEdgeEpsilon(findMinEdgeEpsilon(minEdge, edges));
-		Flower *minGreenFlower(nullptr);
-		double minGreenFlowerEpsilon(findMinGreenFlowerEpsilon(minGreenFlower, flowers));
-
-		// Exit loop if no further power maximization is possible for any flower.
-		if ((minEdge == nullptr) && (minGreenFlower == nullptr)) {
-			break;
+	// Solve a batch. Its instances are spread over the threads instead of the padding computation.
+	if (batchPath != nullptr) {
+		if ((inputPath != nullptr) || (convertPath != nullptr) || (statisticsPath != nullptr)) {
+			printUsage();
+			return 1;
 		}
 
-		// Apply the minimum epsilon.
-		applyEpsilon(std::min(minEdgeEpsilon, minGreenFlowerEpsilon), flowers);
-
-		// Choose action to be executed.
-		if (minEdgeEpsilon > minGreenFlowerEpsilon) {
-			executeBurstFlower(minGreenFlower);
-			flowers.erase(std::remove(flowers.begin(), flowers.end(), minGreenFlower), flowers.end());
-			delete minGreenFlower;
-
-#ifdef ENABLE_DEBUG_CHOSEN_ACTION
-			std::cout << "P1|e=" << minGreenFlowerEpsilon << "|"
-				<< "G" << minGreenFlower->blueStem()->vertexId << "|";
-			std::vector<Flower *> blueSubFlowers(minGreenFlower->blueSubFlowers());
-			STD_VECTOR_CONST_FOREACH_(Flower *, blueSubFlowers, subFlowerIt, subFlowerEnd) {
-				std::cout << (*subFlowerIt)->vertexId << "|";
-			}			
-#endif
-		} else {
-			std::vector<Flower *> freeFlowers(minEdge->freeFlowers());
+		std::vector<std::string> instancePaths;
+		const char *errorMessage(nullptr);
+		if (!collectInstancePaths(batchPath, instancePaths, errorMessage)) {
+			std::cerr << "Error: " << errorMessage << std::endl;
+			return 1;
+		}
 
-			if (testOneIsDumbbell(freeFlowers)) {
-				executeAppendDumbbell(minEdge, freeFlowers);
+		BatchOptions batchOptions;
+		batchOptions.format = inputFormat;
+		batchOptions.threadCount = threadCount;
+		batchOptions.candidateCount = candidateCount;
+		batchOptions.isWarmStartEnabled = isWarmStartEnabled;
+		BatchStatistics batchStatistics;
+		solveBatch(instancePaths, batchOptions, std::cout, batchStatistics);
 
-#ifdef ENABLE_DEBUG_CHOSEN_ACTION
-				std::cout << "P2";
-#endif
-			} else if (testAllRootEquality(freeFlowers)) {
-				flowers.push_back(executeCreateFlower(minEdge, freeFlowers));
+		std::cerr << "Solved " << batchStatistics.instanceCount << " instances in " << batchStatistics.wallSeconds
+			<< " s, " << batchStatistics.instancesPerSecond() << " instances/s, "
+			<< batchStatistics.failedInstanceCount << " failed, "
+			<< batchStatistics.imperfectInstanceCount << " without a complete pairing." << std::endl;
+		return (batchStatistics.failedInstanceCount == 0) ? 0 : 1;
+	}
 
-#ifdef ENABLE_DEBUG_CHOSEN_ACTION
-				std::cout << "P3";
-#endif
-			} else {
-				executeCollapseTree(minEdge, freeFlowers);
-				++pairingEdgeCount;
+	// Read input. Only pricing can solve a graph whose edges are not listed.
+	InputGraph inputGraph;
+	{
+		const char *errorMessage(nullptr);
+		bool isImplicitAllowed((candidateCount > 0) && (convertPath == nullptr));
+		if (!loadGraph(inputPath, inputFormat, isImplicitAllowed, inputGraph, errorMessage)) {
+			std::cerr << "Error: " << errorMessage << std::endl;
+			return 1;
+		}
+	}
+	if (convertPath != nullptr) {
+		if (!saveBinaryGraph(convertPath, inputGraph)) {
+			std::cerr << "Error: The binary graph could not be written." << std::endl;
+			return 1;
+		}
+		return 0;
+	}
 
-#ifdef ENABLE_DEBUG_CHOSEN_ACTION
-				std::cout << "P4";
-#endif
-			}
+	std::signal(STATISTICS_DUMP_SIGNAL, handleStatisticsDumpSignal);
 
-#ifdef ENABLE_DEBUG_CHOSEN_ACTION
-			std::cout << "|e=" << minEdgeEpsilon << "|"
-				<< minEdge->blueFlowers.front()->vertexId << "-"
-				<< minEdge->blueFlowers.back()->vertexId;
-#endif
+	// Solve a bipartite graph without flowers, as it has no odd cycles to shrink.
+	std::vector<char> vertexSides;
+	bool isBipartite((engine != Engine::EDMONDS) && !inputGraph.isImplicit() && findBipartition(inputGraph, vertexSides));
+	if ((engine == Engine::ASSIGNMENT) && !isBipartite) {
+		std::cerr << "Error: The assignment engine needs a bipartite graph." << std::endl;
+		return 1;
+	}
+	if (isBipartite) {
+		AssignmentResult assignment;
+		solveAssignment(inputGraph, vertexSides, assignment);
+		if (!assignment.isPerfect) {
+			std::cerr << "Warning: A complete pairing was not found!" << std::endl;
+		}
+		if ((statisticsPath != nullptr) && !writeStatistics(statisticsPath, assignment.statistics)) {
+			return 1;
 		}
-#ifdef ENABLE_DEBUG_CHOSEN_ACTION
-		std::cout << std::endl;
-#endif
 
-#ifdef ENABLE_DEBUG_GRAPH_STATE
-		STD_VECTOR_CONST_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
-			Flower *flower(*flowerIt);
-			if (flower->isGreen()) {
-				std::cout << "G" << flower->blueStem()->vertexId << "|";
-				std::vector<Flower *> blueSubFlowers(flower->blueSubFlowers());
-				STD_VECTOR_CONST_FOREACH_(Flower *, blueSubFlowers, subFlowerIt, subFlowerEnd) {
-					std::cout << (*subFlowerIt)->vertexId << "|";
-				}
-			} else {
-				std::cout << "B" << flower->vertexId << "|";
-				STD_VECTOR_CONST_FOREACH_(Edge *, flower->edges, edgeIt, edgeEnd) {
-					const Edge *edge(*edgeIt);
-					if (edge->isFull()) {
-						for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
-							if (edge->blueFlowers[i] != flower) {
-								switch (edge->type)
-								{
-								case Edge::Type::FULL_IN_PAIRING:
-									std::cout << "M";
-									break;
-								case Edge::Type::FULL_BLOCKING:
-									std::cout << "L";
-									break;
-								}
-								std::cout << edge->blueFlowers[i]->vertexId << "|";
-								break;
-							}
-						}
-					}					
-				}
-			}
-			std::cout << std::endl;
+		// Output Result.
+		std::cout << std::setprecision(0);
+		std::cout << assignment.weight << std::endl;
+
+		for (std::vector<int>::const_reverse_iterator edgeIt(assignment.pairingEdges.crbegin()),
+			edgeEnd(assignment.pairingEdges.crend()); edgeIt != edgeEnd; ++edgeIt) {
+			printPairingEdge(inputGraph.edges[*edgeIt]);
 		}
-		std::cout << " --- " << std::endl;
-#endif
+		return 0;
 	}
 
-	// Output Result.
-	std::cout << std::setprecision(0);
-#ifdef ENABLE_DEBUG_VERBOUS_OUTPUT
-	if (pairingEdgeCount < (vertexCount / VERTEX_PER_EDGE_COUNT)) {
-		std::cout << "Warning: A complete pairing was not found!" << std::endl;
-	}
-	std::cout << "The following edges belong to the pairing:" << std::endl;
-#endif
+	// Solve a graph that falls apart component by component, as their powers never meet on an edge.
+	std::vector<int> vertexComponents;
+	int componentCount(inputGraph.isImplicit() ? 1 : findComponents(inputGraph, vertexComponents));
+	if (componentCount > 1) {
+		ComponentOptions componentOptions;
+		componentOptions.threadCount = threadCount;
+		componentOptions.candidateCount = candidateCount;
+		componentOptions.isWarmStartEnabled = isWarmStartEnabled;
+		componentOptions.isStatisticsEnabled = statisticsPath != nullptr;
+		ComponentPairing pairing;
+		const char *errorMessage(nullptr);
+		if (!solveComponents(inputGraph, vertexComponents, componentCount, componentOptions, pairing, errorMessage)) {
+			std::cerr << "Error: " << errorMessage << std::endl;
+			return 1;
+		}
+		if (!pairing.isPerfect) {
+			std::cerr << "Warning: A complete pairing was not found!" << std::endl;
+		}
+		if ((statisticsPath != nullptr) && !writeStatistics(statisticsPath, pairing.statistics)) {
+			return 1;
+		}
+
+		// Output Result.
+		std::cout << std::setprecision(0);
+		std::cout << pairing.weight << std::endl;
 
-	double weightSum(0.0);
-	std::reverse(edges.begin(), edges.end());
-	STD_VECTOR_FOREACH_(Edge *, edges, edgeIt, edgeEnd) {
-		Edge *edge(*edgeIt);
-		if (edge->type == Edge::Type::FULL_IN_PAIRING) {
-			weightSum += edge->weight;
+		STD_VECTOR_CONST_FOREACH_(InputEdge, pairing.edges, edgeIt, edgeEnd) {
+			printPairingEdge(*edgeIt);
 		}
+		return 0;
 	}
-	std::cout << weightSum << std::endl;
-
-	STD_VECTOR_FOREACH_(Edge *, edges, edgeIt, edgeEnd) {
-		Edge *edge(*edgeIt);
-		if (edge->type == Edge::Type::FULL_IN_PAIRING) {
-			std::cout << edge->blueFlowers[0]->vertexId;
-			for (int i(1); i < VERTEX_PER_EDGE_COUNT; ++i) {
-				std::cout << " " << edge->blueFlowers[i]->vertexId;
-			}
-			std::cout << std::endl;
+
+	// Solve.
+	MatchingSolver solver;
+	solver.setThreadCount(threadCount);
+	solver.setWarmStartEnabled(isWarmStartEnabled);
+	solver.setStatisticsEnabled(statisticsPath != nullptr);
+	bool isPerfect(false);
+	if (candidateCount > 0) {
+		const char *errorMessage(nullptr);
+		PricingStatistics pricingStatistics;
+		if (!solveWithPricing(std::move(inputGraph), candidateCount, solver, isPerfect, pricingStatistics, errorMessage)) {
+			std::cerr << "Error: " << errorMessage << std::endl;
+			return 1;
 		}
+	} else {
+		const char *errorMessage(nullptr);
+		if (!solver.setGraph(std::move(inputGraph), errorMessage)) {
+			std::cerr << "Error: " << errorMessage << std::endl;
+			return 1;
+		}
+		isPerfect = solver.solve();
+	}
+	if (!isPerfect) {
+		std::cerr << "Warning: A complete pairing was not found!" << std::endl;
 	}
 
-	// Deinitialize all Flowers.
-	STD_VECTOR_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
-		delete *flowerIt;
+	if ((statisticsPath != nullptr) && !writeStatistics(statisticsPath, solver.statistics())) {
+		return 1;
 	}
 
-	// Deinitialize Edges.
-	STD_VECTOR_FOREACH_(Edge *, edges, edgeIt, edgeEnd) {
-		delete *edgeIt;
+	// Output Result.
+	std::cout << std::setprecision(0);
+	std::cout << solver.pairingWeight() << std::endl;
+
+	const std::vector<int> &pairingEdges(solver.pairingEdges());
+	for (std::vector<int>::const_reverse_iterator edgeIt(pairingEdges.crbegin()), edgeEnd(pairingEdges.crend());
+		edgeIt != edgeEnd; ++edgeIt) {
+		std::cout << solver.edgeVertex(*edgeIt, 0) + 1;
+		for (int i(1); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			std::cout << " " << solver.edgeVertex(*edgeIt, i) + 1;
+		}
+		std::cout << std::endl;
 	}
 
+	// Flowers and Edges are deinitialized with the solver.
+
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,735 @@
+#include "MatchingSolver.h"
+
+#include "Actions.h"
+#include "Evaluation.h"
+#include "EventQueue.h"
+#include "Loader.h"
+#include "Pool.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+#include "Types.h"
+#include "Utility.h"
+#include "WarmStart.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+bool testOneIsDumbbell(const std::vector<Flower *> &flowers)
+{
+	for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+		if (flowers[i]->isInDumbbell()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool testAllRootEquality(const std::vector<Flower *> &flowers)
+{
+	int treeId(flowers[0]->treeId);
+	for (int i(1); i < VERTEX_PER_EDGE_COUNT; ++i) {
+		if (treeId != flowers[i]->treeId) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Checks that the weight can be stored, which fails for fractional weights if integer weights are enabled.
+bool testWeightValidity(double weight)
+{
+#ifdef ENABLE_INTEGER_WEIGHTS
+	return weight == static_cast<double>(static_cast<Weight>(weight));
+#else
+	(void)weight;
+	return true;
+#endif
+}
+
+// Returns the padding of the edge, which unlike the queued padding is also computed for full edges.
+Weight computeExactEdgePadding(const Edge *edge, const std::vector<Flower *> &flowers, Weight dualOffset)
+{
+	int incrementableFlowerCount(0);
+	return edge->weight - edge->crossedPower(flowers, dualOffset, incrementableFlowerCount);
+}
+
+// Gives the flower its own copy of the edges it views, as the adjacency array of blue flowers cannot change.
+void copyViewedEdges(Flower *flower)
+{
+	if (flower->outgoingEdges.empty()) {
+		flower->outgoingEdges.assign(flower->edges.firstIndex(), flower->edges.lastIndex());
+	}
+}
+
+void attachEdge(Flower *flower, int edge, const IndexedPool<Edge> &edgePool)
+{
+	copyViewedEdges(flower);
+	flower->outgoingEdges.push_back(edge);
+	flower->edges = EdgeRange(flower->outgoingEdges.data(), flower->outgoingEdges.data() + flower->outgoingEdges.size(),
+		&edgePool);
+}
+
+void detachEdge(Flower *flower, int edge, const IndexedPool<Edge> &edgePool)
+{
+	copyViewedEdges(flower);
+	std::vector<int> &outgoingEdges(flower->outgoingEdges);
+	outgoingEdges.erase(std::remove(outgoingEdges.begin(), outgoingEdges.end(), edge), outgoingEdges.end());
+	flower->edges = EdgeRange(outgoingEdges.data(), outgoingEdges.data() + outgoingEdges.size(), &edgePool);
+}
+
+#ifdef ENABLE_INTEGER_WEIGHTS
+// Returns the sum of the powers of all flowers containing the blue stem of the flower.
+Weight computeStemPotential(Flower *flower, Weight dualOffset)
+{
+	Weight potential(0);
+	for (Flower *stemFlower(flower); stemFlower != nullptr; stemFlower = stemFlower->stemSubFlower) {
+		potential += stemFlower->power(dualOffset);
+	}
+	return potential;
+}
+#endif
+
+MatchingSolver::MatchingSolver()
+: isWarmStartEnabled(true)
+, isResolvable(false)
+{}
+
+void MatchingSolver::setThreadCount(int threadCount)
+{
+	// The pool is only needed when the scans are split.
+	this->threadPool.reset((threadCount > 1) ? new ThreadPool(threadCount) : nullptr);
+	this->eventQueue.setThreadPool(this->threadPool.get());
+}
+
+void MatchingSolver::setWarmStartEnabled(bool isWarmStartEnabled)
+{
+	this->isWarmStartEnabled = isWarmStartEnabled;
+}
+
+void MatchingSolver::setStatisticsEnabled(bool isStatisticsEnabled)
+{
+	this->solverStatistics.setEnabled(isStatisticsEnabled);
+}
+
+void MatchingSolver::clear()
+{
+	this->graph.vertexCount = 0;
+	this->graph.edges.clear();
+	this->removedEdges.clear();
+	this->isResolvable = false;
+	this->pairingEdgeIndices.clear();
+	this->mates.clear();
+}
+
+int MatchingSolver::addVertices(int count)
+{
+	int firstVertex(this->graph.vertexCount);
+	this->graph.vertexCount += count;
+
+	// The blue flowers of the new vertices would follow the green flowers, so the next resolve starts anew.
+	if (count > 0) {
+		this->isResolvable = false;
+	}
+	return firstVertex;
+}
+
+bool MatchingSolver::addEdge(int vertexA, int vertexB, double weight, const char *&errorMessage)
+{
+	bool isVertexValid((vertexA >= 0) && (vertexA < this->graph.vertexCount)
+		&& (vertexB >= 0) && (vertexB < this->graph.vertexCount));
+	if (!isVertexValid) {
+		errorMessage = "An edge refers to a vertex that does not exist.";
+		return false;
+	}
+	if (vertexA == vertexB) {
+		errorMessage = "An added edge must join two distinct vertices.";
+		return false;
+	}
+	if (!testWeightValidity(weight)) {
+		errorMessage = "Integer weights are enabled, but an edge has a fractional weight.";
+		return false;
+	}
+
+	// The vertices of the graph are numbered from one, just as in the input.
+	InputEdge edge;
+	edge.vertexIds[0] = vertexA + 1;
+	edge.vertexIds[1] = vertexB + 1;
+	edge.weight = weight;
+	this->graph.edges.push_back(edge);
+	this->removedEdges.push_back(false);
+
+	if (this->isResolvable) {
+		Edge *addedEdge(this->edgePool.create());
+		addedEdge->weight = static_cast<Weight>(weight) * WEIGHT_SCALE;
+		addedEdge->blueFlowerIndices[0] = vertexA;
+		addedEdge->blueFlowerIndices[1] = vertexB;
+
+		// Green flowers find the edge through their blue flowers.
+		for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			attachEdge(addedEdge->blueFlower(i, this->flowers), this->edgePool.size() - 1, this->edgePool);
+		}
+		this->repairEdge(addedEdge);
+	}
+	return true;
+}
+
+bool MatchingSolver::setEdgeWeight(int edge, double weight, const char *&errorMessage)
+{
+	if ((edge < 0) || (edge >= this->edgeCount()) || this->removedEdges[edge]) {
+		errorMessage = "The edge does not exist.";
+		return false;
+	}
+	if (!testWeightValidity(weight)) {
+		errorMessage = "Integer weights are enabled, but an edge has a fractional weight.";
+		return false;
+	}
+
+	this->graph.edges[edge].weight = weight;
+
+	if (this->isResolvable) {
+		Edge *changedEdge(this->edgePool.at(edge));
+		changedEdge->weight = static_cast<Weight>(weight) * WEIGHT_SCALE;
+		this->repairEdge(changedEdge);
+	}
+	return true;
+}
+
+bool MatchingSolver::removeEdge(int edge, const char *&errorMessage)
+{
+	if ((edge < 0) || (edge >= this->edgeCount())) {
+		errorMessage = "The edge does not exist.";
+		return false;
+	}
+	if (this->removedEdges[edge]) {
+		return true;
+	}
+	this->removedEdges[edge] = true;
+
+	if (this->isResolvable) {
+		Edge *removedEdge(this->edgePool.at(edge));
+
+		// A full edge holds a pairing or a cycle together, which must be taken apart first.
+		if (removedEdge->isFull()) {
+			this->separateEdge(removedEdge);
+		}
+
+		// The edge stays allocated, but no flower views it anymore, so it is never queued again.
+		this->eventQueue.removeEdge(removedEdge);
+		for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+			detachEdge(removedEdge->blueFlower(i, this->flowers), edge, this->edgePool);
+		}
+		removedEdge->isRemoved = true;
+	}
+	return true;
+}
+
+bool MatchingSolver::isEdgeRemoved(int edge) const
+{
+	return this->removedEdges[edge];
+}
+
+bool MatchingSolver::setGraph(InputGraph &&graph, const char *&errorMessage)
+{
+	if (graph.isImplicit()) {
+		errorMessage = "An implicit complete graph can only be solved with pricing.";
+		return false;
+	}
+	STD_VECTOR_CONST_FOREACH_(InputEdge, graph.edges, edgeIt, edgeEnd) {
+		if (!testWeightValidity(edgeIt->weight)) {
+			errorMessage = "Integer weights are enabled, but an edge has a fractional weight.";
+			return false;
+		}
+	}
+
+	this->clear();
+	this->graph.vertexCount = graph.vertexCount;
+	this->graph.edges.swap(graph.edges);
+	this->removedEdges.assign(this->graph.edges.size(), false);
+	return true;
+}
+
+int MatchingSolver::vertexCount() const
+{
+	return this->graph.vertexCount;
+}
+
+int MatchingSolver::edgeCount() const
+{
+	return static_cast<int>(this->graph.edges.size());
+}
+
+int MatchingSolver::edgeVertex(int edge, int end) const
+{
+	return this->graph.edges[edge].vertexIds[end] - 1;
+}
+
+double MatchingSolver::edgeWeight(int edge) const
+{
+	return this->graph.edges[edge].weight;
+}
+
+bool MatchingSolver::solve()
+{
+	this->solverStatistics.clear();
+	this->eventQueue.resetScannedEdgeCount();
+
+	{
+		PhaseTimer timer(this->solverStatistics, Phase::CREATE_FLOWERS_AND_EDGES);
+		this->createFlowersAndEdges();
+	}
+	this->solverStatistics.peakFlowerCount = static_cast<int>(this->flowers.size());
+
+	// Pair flowers greedily before the first edge is queued.
+	if (this->isWarmStartEnabled) {
+		PhaseTimer timer(this->solverStatistics, Phase::WARM_START);
+		executeWarmStart(this->flowers);
+	}
+
+	// Queue all edges.
+	{
+		PhaseTimer timer(this->solverStatistics, Phase::INITIALIZE_QUEUE);
+		this->eventQueue.initialize(this->edgePool, this->flowers);
+	}
+
+	this->runCoreLoop();
+	{
+		PhaseTimer timer(this->solverStatistics, Phase::COLLECT_PAIRING);
+		this->collectPairing();
+	}
+	this->updateStatistics();
+
+	this->isResolvable = static_cast<int>(this->pairingEdgeIndices.size()) * VERTEX_PER_EDGE_COUNT == this->graph.vertexCount;
+	return this->isResolvable;
+}
+
+bool MatchingSolver::resolve()
+{
+	if (!this->isResolvable) {
+		return this->solve();
+	}
+
+#ifdef ENABLE_INTEGER_WEIGHTS
+	this->equalizeRootParity();
+#endif
+	this->exposedRoots.clear();
+
+	// The repairs have touched every changed flower, so the loop requeues their edges first.
+	this->solverStatistics.clear();
+	this->solverStatistics.peakFlowerCount = static_cast<int>(this->flowers.size());
+	this->eventQueue.resetScannedEdgeCount();
+	this->runCoreLoop();
+	{
+		PhaseTimer timer(this->solverStatistics, Phase::COLLECT_PAIRING);
+		this->collectPairing();
+	}
+	this->updateStatistics();
+
+	this->isResolvable = static_cast<int>(this->pairingEdgeIndices.size()) * VERTEX_PER_EDGE_COUNT == this->graph.vertexCount;
+	return this->isResolvable;
+}
+
+const std::vector<int> &MatchingSolver::pairingEdges() const
+{
+	return this->pairingEdgeIndices;
+}
+
+int MatchingSolver::mate(int vertex) const
+{
+	return this->mates[vertex];
+}
+
+double MatchingSolver::pairingWeight() const
+{
+	Weight weightSum(0);
+	STD_VECTOR_CONST_FOREACH_(int, this->pairingEdgeIndices, edgeIndexIt, edgeIndexEnd) {
+		weightSum += this->edgePool.at(*edgeIndexIt)->weight;
+	}
+	return static_cast<double>(weightSum) / WEIGHT_SCALE;
+}
+
+double MatchingSolver::vertexDual(int vertex) const
+{
+	return static_cast<double>(this->flowers[vertex]->power(this->eventQueue.dualOffset())) / WEIGHT_SCALE;
+}
+
+double MatchingSolver::edgePadding(int vertexA, int vertexB, double weight) const
+{
+	// The edge is never attached, it only gives the walk through the flowers its blue flowers.
+	Edge edge;
+	edge.weight = static_cast<Weight>(weight) * WEIGHT_SCALE;
+	edge.blueFlowerIndices[0] = vertexA;
+	edge.blueFlowerIndices[1] = vertexB;
+	return static_cast<double>(computeExactEdgePadding(&edge, this->flowers, this->eventQueue.dualOffset())) / WEIGHT_SCALE;
+}
+
+double MatchingSolver::vertexPowerSum(int vertex) const
+{
+	Weight powerSum(0);
+	for (const Flower *flower(this->flowers[vertex]); flower != nullptr; flower = flower->enclosingFlower) {
+		powerSum += flower->power(this->eventQueue.dualOffset());
+	}
+	return static_cast<double>(powerSum) / WEIGHT_SCALE;
+}
+
+const SolverStatistics &MatchingSolver::statistics() const
+{
+	return this->solverStatistics;
+}
+
+double MatchingSolver::dualObjective() const
+{
+	Weight powerSum(0);
+	STD_VECTOR_CONST_FOREACH_(Flower *, this->flowers, flowerIt, flowerEnd) {
+		powerSum += (*flowerIt)->power(this->eventQueue.dualOffset());
+	}
+	return static_cast<double>(powerSum) / WEIGHT_SCALE;
+}
+
+void MatchingSolver::createFlowersAndEdges()
+{
+	int vertexCount(this->graph.vertexCount);
+	int edgeCount(static_cast<int>(this->graph.edges.size()));
+
+	// The queue refers to the flowers and edges of the previous solve, which are about to be destroyed.
+	this->eventQueue.clear();
+	this->exposedRoots.clear();
+	this->flowerPool.reset();
+	this->edgePool.reset();
+
+	// Initialize Blue Flowers.
+	this->flowerPool.reserve(vertexCount);
+	this->flowers.resize(vertexCount);
+	for (int i(0); i < vertexCount; ++i) {
+		Flower *&flower(this->flowers[i]);
+		flower = this->flowerPool.create();
+		flower->vertexId = i + 1;
+		flower->treeId = i;
+	}
+
+	// Initialize Edges.
+	for (int i(0); i < edgeCount; ++i) {
+		const InputEdge &inputEdge(this->graph.edges[i]);
+		Edge *edge(this->edgePool.create());
+
+		// Removed edges keep their index, but are left out of the adjacency.
+		for (int j(0); j < VERTEX_PER_EDGE_COUNT; ++j) {
+			edge->blueFlowerIndices[j] = inputEdge.vertexIds[j] - 1;
+		}
+		edge->isRemoved = this->removedEdges[i];
+
+		edge->weight = static_cast<Weight>(inputEdge.weight) * WEIGHT_SCALE;
+	}
+
+	// Build the adjacency of Blue Flowers as one array, in which each flower owns a contiguous slice.
+	this->adjacencyOffsets.assign(vertexCount + 1, 0);
+	for (int i(0); i < edgeCount; ++i) {
+		if (this->removedEdges[i]) {
+			continue;
+		}
+		for (int j(0); j < VERTEX_PER_EDGE_COUNT; ++j) {
+			++this->adjacencyOffsets[this->graph.edges[i].vertexIds[j]];
+		}
+	}
+	for (int i(0); i < vertexCount; ++i) {
+		this->adjacencyOffsets[i + 1] += this->adjacencyOffsets[i];
+	}
+	this->adjacency.resize(this->adjacencyOffsets[vertexCount]);
+	this->adjacencyPositions.assign(this->adjacencyOffsets.begin(), this->adjacencyOffsets.end() - 1);
+	for (int i(0); i < edgeCount; ++i) {
+		if (this->removedEdges[i]) {
+			continue;
+		}
+		for (int j(0); j < VERTEX_PER_EDGE_COUNT; ++j) {
+			this->adjacency[this->adjacencyPositions[this->graph.edges[i].vertexIds[j] - 1]++] = i;
+		}
+	}
+	for (int i(0); i < vertexCount; ++i) {
+		this->flowers[i]->edges = EdgeRange(this->adjacency.data() + this->adjacencyOffsets[i],
+			this->adjacency.data() + this->adjacencyOffsets[i + 1], &this->edgePool);
+	}
+}
+
+void MatchingSolver::runCoreLoop()
+{
+	FOREVER {
+		// Answer a dump requested by a signal between two iterations, when the graph state is consistent.
+		if (takeStatisticsDumpRequest()) {
+			this->updateStatistics();
+			this->solverStatistics.writeJson(std::cerr);
+			std::cerr << std::endl;
+		}
+
+		// Requeue the edges of flowers changed by the previous actions.
+		{
+			PhaseTimer timer(this->solverStatistics, Phase::REFRESH_QUEUE);
+			this->eventQueue.refreshTouchedFlowers();
+		}
+
+		// Find the min epsilon.
+		Edge *minEdge(nullptr);
+		Weight minEdgeEpsilon(0);
+		{
+			PhaseTimer timer(this->solverStatistics, Phase::FIND_MIN_EDGE_EPSILON);
+			minEdgeEpsilon = findMinEdgeEpsilon(minEdge, this->eventQueue);
+		}
+		Flower *minGreenFlower(nullptr);
+		Weight minGreenFlowerEpsilon(0);
+		{
+			PhaseTimer timer(this->solverStatistics, Phase::FIND_MIN_GREEN_FLOWER_EPSILON);
+			minGreenFlowerEpsilon = findMinGreenFlowerEpsilon(minGreenFlower, this->eventQueue);
+		}
+
+#ifdef ENABLE_DEBUG_ASSERTIONS
+		// ASSERTION: The queues find the same epsilon value as a full scan of all edges.
+		{
+			Edge *scannedMinEdge(nullptr);
+			Weight scannedMinEdgeEpsilon(this->eventQueue.scanMinEdgeEpsilon(this->edgePool, this->flowers, scannedMinEdge));
+			Weight difference(scannedMinEdgeEpsilon - minEdgeEpsilon);
+			if (((scannedMinEdge == nullptr) != (minEdge == nullptr))
+				|| ((minEdge != nullptr) && ((difference > 1e-6) || (difference < -1e-6)))) {
+				std::cout << "Assertion failed: The queued min epsilon " << minEdgeEpsilon
+					<< " differs from the scanned min epsilon " << scannedMinEdgeEpsilon << "." << std::endl;
+				std::exit(-1);
+			}
+		}
+#endif
+
+		// Exit loop if no further power maximization is possible for any flower.
+		if ((minEdge == nullptr) && (minGreenFlower == nullptr)) {
+			break;
+		}
+
+		++this->solverStatistics.iterationCount;
+
+		// Collect all events at the min epsilon, which remain tight while the actions keep every power.
+		Weight epsilon(std::min(minEdgeEpsilon, minGreenFlowerEpsilon));
+		{
+			PhaseTimer timer(this->solverStatistics, Phase::COLLECT_EVENTS);
+			this->minEdges.clear();
+			if (minEdgeEpsilon == epsilon) {
+				findMinEdges(minEdgeEpsilon, this->minEdges, this->eventQueue);
+			}
+			this->minGreenFlowers.clear();
+			if (minGreenFlowerEpsilon == epsilon) {
+				findMinGreenFlowers(minGreenFlowerEpsilon, this->minGreenFlowers, this->eventQueue);
+			}
+		}
+
+		// Apply the minimum epsilon.
+		{
+			PhaseTimer timer(this->solverStatistics, Phase::APPLY_EPSILON);
+			applyEpsilon(epsilon, this->eventQueue);
+		}
+
+		// Execute the actions of all edges that are still tight, choosing each by the current tree structure.
+		STD_VECTOR_CONST_FOREACH_(Edge *, this->minEdges, minEdgeIt, minEdgeEnd) {
+			Edge *minEdge(*minEdgeIt);
+			if (!testEdgeEventValidity(minEdge, this->flowers)) {
+				continue;
+			}
+
+			std::vector<Flower *> freeFlowers(minEdge->freeFlowers(this->flowers));
+
+			if (testOneIsDumbbell(freeFlowers)) {
+				PhaseTimer timer(this->solverStatistics, Phase::APPEND_DUMBBELL);
+				executeAppendDumbbell(minEdge, freeFlowers, this->eventQueue);
+			} else if (testAllRootEquality(freeFlowers)) {
+				PhaseTimer timer(this->solverStatistics, Phase::CREATE_FLOWER);
+				Flower *createdFlower(executeCreateFlower(minEdge, freeFlowers, this->eventQueue, this->flowerPool));
+				this->flowers.push_back(createdFlower);
+
+				// Only created flowers increase the flower count or the nesting depth.
+				this->solverStatistics.peakFlowerCount = std::max(this->solverStatistics.peakFlowerCount,
+					static_cast<int>(this->flowers.size()));
+				this->solverStatistics.maxNestingDepth = std::max(this->solverStatistics.maxNestingDepth,
+					createdFlower->nestingHeight);
+			} else {
+				PhaseTimer timer(this->solverStatistics, Phase::COLLAPSE_TREE);
+				executeCollapseTree(minEdge, freeFlowers, this->eventQueue, this->pathBuffers);
+			}
+		}
+
+		// Burst the green flowers that are still odd, after the edges, as ties were resolved before.
+		STD_VECTOR_CONST_FOREACH_(Flower *, this->minGreenFlowers, minGreenFlowerIt, minGreenFlowerEnd) {
+			Flower *minGreenFlower(*minGreenFlowerIt);
+			if (!testGreenFlowerEventValidity(minGreenFlower)) {
+				continue;
+			}
+
+			{
+				PhaseTimer timer(this->solverStatistics, Phase::BURST_FLOWER);
+				executeBurstFlower(minGreenFlower, this->eventQueue);
+				this->flowers.erase(std::remove(this->flowers.begin(), this->flowers.end(), minGreenFlower),
+					this->flowers.end());
+			}
+
+			// The slot of the burst flower is recycled by the next created flower.
+			this->flowerPool.destroy(minGreenFlower);
+		}
+	}
+}
+
+void MatchingSolver::updateStatistics()
+{
+	this->solverStatistics.scannedEdgeCount = this->eventQueue.scannedEdgeCount();
+	this->solverStatistics.blossomCount = static_cast<int>(this->flowers.size()) - this->graph.vertexCount;
+	this->solverStatistics.edgeCount = this->edgeCount();
+	this->solverStatistics.memoryBytes = static_cast<long long>(this->measureMemoryBytes());
+}
+
+std::size_t MatchingSolver::measureMemoryBytes() const
+{
+	std::size_t memoryBytes(this->graph.edges.capacity() * sizeof(InputEdge) + this->removedEdges.capacity() / CHAR_BIT
+		+ this->flowerPool.capacityBytes() + this->edgePool.capacityBytes() + this->flowers.capacity() * sizeof(Flower *)
+		+ (this->adjacencyOffsets.capacity() + this->adjacencyPositions.capacity() + this->adjacency.capacity()) * sizeof(int)
+		+ this->eventQueue.capacityBytes() + (this->pairingEdgeIndices.capacity() + this->mates.capacity()) * sizeof(int));
+
+	// Flowers keep their arrays of subflowers, cycle edges, children and outgoing edges outside of the pool.
+	STD_VECTOR_CONST_FOREACH_(Flower *, this->flowers, flowerIt, flowerEnd) {
+		const Flower *flower(*flowerIt);
+		memoryBytes += (flower->subFlowers.capacity() + flower->children.capacity()) * sizeof(Flower *)
+			+ flower->cycleEdges.capacity() * sizeof(Edge *) + flower->outgoingEdges.capacity() * sizeof(int);
+	}
+	return memoryBytes;
+}
+
+void MatchingSolver::collectPairing()
+{
+	this->pairingEdgeIndices.clear();
+	this->mates.assign(this->graph.vertexCount, -1);
+	for (int i(0), edgeCount(this->edgePool.size()); i < edgeCount; ++i) {
+		const Edge *edge(this->edgePool.at(i));
+		if (edge->type == Edge::Type::FULL_IN_PAIRING) {
+			this->pairingEdgeIndices.push_back(i);
+			this->mates[edge->blueFlowerIndices[0]] = edge->blueFlowerIndices[1];
+			this->mates[edge->blueFlowerIndices[1]] = edge->blueFlowerIndices[0];
+		}
+	}
+}
+
+void MatchingSolver::repairEdge(Edge *edge)
+{
+	Weight weightPadding(computeExactEdgePadding(edge, this->flowers, this->eventQueue.dualOffset()));
+
+	// A full edge must stay without padding, any other edge must keep a nonnegative padding.
+	bool isFeasible(edge->isFull() ? (weightPadding == 0) : (weightPadding >= 0));
+	if (!isFeasible) {
+		this->separateEdge(edge);
+
+		// The edge now crosses every flower containing its first blue flower, and a loop crosses it twice.
+		if (weightPadding < 0) {
+			Weight decrease(-weightPadding);
+			if (edge->blueFlowerIndices[0] == edge->blueFlowerIndices[1]) {
+#ifdef ENABLE_INTEGER_WEIGHTS
+				decrease = (decrease + 1) / 2;
+#else
+				decrease /= 2;
+#endif
+			}
+			this->lowerContainingPowers(edge->blueFlower(0, this->flowers), decrease);
+		}
+	}
+
+	this->eventQueue.updateEdge(edge);
+}
+
+void MatchingSolver::separateEdge(Edge *edge)
+{
+	Flower *blueFlowerA(edge->blueFlower(0, this->flowers));
+	Flower *blueFlowerB(edge->blueFlower(1, this->flowers));
+
+	FOREVER {
+		Flower *outerFlower(blueFlowerA->outerFlower());
+		bool isEdgeWithin(outerFlower == blueFlowerB->outerFlower());
+
+		// Without trees, a full edge between two free flowers is the pairing edge of their dumbbell.
+		if (outerFlower->isInDumbbell() && (isEdgeWithin || edge->isFull())) {
+			this->splitDumbbell(outerFlower);
+		}
+
+		if (!isEdgeWithin || !outerFlower->isGreen()) {
+			break;
+		}
+		this->dissolveFlower(outerFlower);
+	}
+}
+
+void MatchingSolver::lowerContainingPowers(Flower *blueFlower, Weight decrease)
+{
+	Weight dualOffset(this->eventQueue.dualOffset());
+
+	while (decrease > 0) {
+		Flower *outerFlower(blueFlower->outerFlower());
+
+		if (outerFlower->isInDumbbell()) {
+			this->splitDumbbell(outerFlower);
+		}
+
+		// The outer flower is now an exposed root, so no full edge crosses it and its power can be lowered.
+		// The power of a green flower cannot drop below zero, so the rest of the decrease goes to its subflowers.
+		Weight power(outerFlower->power(dualOffset));
+		if (outerFlower->isGreen() && (power < decrease)) {
+			decrease -= power;
+			this->dissolveFlower(outerFlower);
+		} else {
+			outerFlower->setPower(power - decrease, dualOffset);
+			this->eventQueue.touchFlower(outerFlower);
+			break;
+		}
+	}
+}
+
+void MatchingSolver::splitDumbbell(Flower *dumbbellFlower)
+{
+	Edge *pairingEdge(dumbbellFlower->inPairingEdge(this->flowers));
+	std::vector<Flower *> freeFlowers(pairingEdge->freeFlowers(this->flowers));
+	executeSplitDumbbell(pairingEdge, freeFlowers, this->eventQueue);
+	this->exposedRoots.insert(this->exposedRoots.end(), freeFlowers.begin(), freeFlowers.end());
+}
+
+void MatchingSolver::dissolveFlower(Flower *rootFlower)
+{
+	// The stem subflower takes over the place of the flower among the exposed roots.
+	std::replace(this->exposedRoots.begin(), this->exposedRoots.end(), rootFlower, rootFlower->stemSubFlower);
+
+	executeDissolveFlower(rootFlower, this->eventQueue);
+	this->flowers.erase(std::remove(this->flowers.begin(), this->flowers.end(), rootFlower), this->flowers.end());
+	this->flowerPool.destroy(rootFlower);
+}
+
+#ifdef ENABLE_INTEGER_WEIGHTS
+void MatchingSolver::equalizeRootParity()
+{
+	if (this->exposedRoots.empty()) {
+		return;
+	}
+
+	// The paddings between two trees are even if the powers containing their stems have equal parities.
+	// Dumbbells always match the parity of the tree they are appended to, as their edges are full.
+	Weight dualOffset(this->eventQueue.dualOffset());
+	Weight targetPotential(computeStemPotential(this->exposedRoots.front(), dualOffset));
+	for (int i(1); i < static_cast<int>(this->exposedRoots.size());) {
+		Flower *rootFlower(this->exposedRoots[i]);
+		if ((computeStemPotential(rootFlower, dualOffset) - targetPotential) % 2 == 0) {
+			++i;
+			continue;
+		}
+
+		// Exposed roots have no full outgoing edges, so their powers can be lowered down to zero.
+		Weight power(rootFlower->power(dualOffset));
+		if (rootFlower->isGreen() && (power == 0)) {
+			this->dissolveFlower(rootFlower);
+		} else {
+			rootFlower->setPower(power - 1, dualOffset);
+			this->eventQueue.touchFlower(rootFlower);
+			++i;
+		}
+	}
+}
+#endif
\ No newline at end of file
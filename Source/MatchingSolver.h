@@ -0,0 +1,159 @@
+#ifndef EDMONDS_ALGORITHM_MATCHING_SOLVER_H
+#define EDMONDS_ALGORITHM_MATCHING_SOLVER_H
+
+#include "Actions.h"
+#include "EventQueue.h"
+#include "Loader.h"
+#include "Pool.h"
+#include "Statistics.h"
+#include "ThreadPool.h"
+#include "Types.h"
+#include "Utility.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Finds a perfect pairing of minimum weight in a graph built through this class.
+// Vertices and edges are indexed from zero in the order of their addition.
+// All buffers are kept between calls of solve and clear, so that solving many graphs allocates little memory.
+class MatchingSolver
+{
+public:
+	MatchingSolver();
+
+	// Splits the padding computation that fills the initial edge queue between the given number of threads.
+	// The solve loop itself stays serial, as it only updates the edges of touched flowers.
+	void setThreadCount(int threadCount);
+
+	// Starts each solve from a greedy pairing instead of an empty one, which is the default.
+	void setWarmStartEnabled(bool isWarmStartEnabled);
+
+	// Measures the time of every phase and the nesting depth of the flowers in addition to the counters, see statistics.
+	void setStatisticsEnabled(bool isStatisticsEnabled);
+
+	// Removes all vertices and edges.
+	void clear();
+
+	// Adds the given number of vertices and returns the index of the first one.
+	int addVertices(int count);
+
+	// Adds an edge between two distinct existing vertices, which gets the next edge index.
+	// A loop could never be paired, so it is rejected.
+	// On failure an error message is stored and false is returned.
+	bool addEdge(int vertexA, int vertexB, double weight, const char *&errorMessage);
+
+	// Changes the weight of an edge that has not been removed.
+	// On failure an error message is stored and false is returned.
+	bool setEdgeWeight(int edge, double weight, const char *&errorMessage);
+
+	// Removes an edge from the graph, while its index stays reserved. Removing an edge again does nothing.
+	// On failure an error message is stored and false is returned.
+	bool removeEdge(int edge, const char *&errorMessage);
+
+	// The edge index must be below edgeCount().
+	bool isEdgeRemoved(int edge) const;
+
+	// Replaces the graph with a loaded one, taking over its edges.
+	// On failure an error message is stored and false is returned.
+	bool setGraph(InputGraph &&graph, const char *&errorMessage);
+
+	int vertexCount() const;
+	int edgeCount() const;
+
+	int edgeVertex(int edge, int end) const;
+	double edgeWeight(int edge) const;
+
+	// Runs the algorithm from the beginning. Returns whether a perfect pairing exists.
+	bool solve();
+
+	// Continues the algorithm from the result of the last solve, which is repaired after every change of the edges.
+	// Only the flowers around the changed edges are rebuilt, so the work scales with the size of the changes.
+	// Runs the algorithm from the beginning if the last solve found no perfect pairing or vertices have been added.
+	// Returns whether a perfect pairing exists.
+	bool resolve();
+
+	// The following methods describe the result of the last solve or resolve.
+
+	// Indices of the edges in the pairing, in increasing order.
+	const std::vector<int> &pairingEdges() const;
+
+	// Returns the vertex paired with the given one, or -1 if it is unpaired.
+	int mate(int vertex) const;
+
+	double pairingWeight() const;
+
+	// Returns the power of the blue flower of the vertex.
+	double vertexDual(int vertex) const;
+
+	// Returns the padding that an edge with the given weight between two vertices would have under the current powers.
+	// A negative padding means that the powers are not feasible once the edge is added.
+	double edgePadding(int vertexA, int vertexB, double weight) const;
+
+	// Returns the powers of the blue flower of the vertex and of all green flowers containing it summed up.
+	// Green flowers never have a negative power, so an edge at least as heavy as the sums of its vertices has no negative padding.
+	double vertexPowerSum(int vertex) const;
+
+	// Returns the sum of the powers of all flowers, which equals the pairing weight if the pairing is perfect.
+	double dualObjective() const;
+
+	const SolverStatistics &statistics() const;
+
+private:
+	InputGraph graph;
+	std::vector<bool> removedEdges;
+	bool isWarmStartEnabled;
+
+	// Whether the flowers hold the optimum of a perfect pairing, from which resolve can continue.
+	bool isResolvable;
+
+	std::unique_ptr<ThreadPool> threadPool;
+
+	Pool<Flower> flowerPool;
+	// Each edge is found by its index, so that the adjacency stores indices instead of pointers.
+	IndexedPool<Edge> edgePool;
+
+	// The blue flowers come first, in the order of their vertices, followed by the green flowers.
+	std::vector<Flower *> flowers;
+
+	std::vector<int> adjacencyOffsets;
+	std::vector<int> adjacencyPositions;
+	std::vector<int> adjacency;
+
+	SolverStatistics solverStatistics;
+
+	EventQueue eventQueue;
+	std::vector<Edge *> minEdges;
+	std::vector<Flower *> minGreenFlowers;
+	AlternatingPathBuffers pathBuffers;
+
+	// Roots of the trees created by the repairs since the last solve.
+	std::vector<Flower *> exposedRoots;
+
+	std::vector<int> pairingEdgeIndices;
+	std::vector<int> mates;
+
+	void createFlowersAndEdges();
+	void runCoreLoop();
+	void collectPairing();
+	// Copies the counters kept by the event queue and the flowers into the statistics.
+	void updateStatistics();
+	// Returns the number of bytes held by the graph, the flowers, the edges and the queues.
+	std::size_t measureMemoryBytes() const;
+
+	// Restores the dual feasibility of an edge after a change of its weight or flowers.
+	void repairEdge(Edge *edge);
+	// Dissolves the flowers containing both ends of the edge and unpairs the edge,
+	// so that it becomes a regular edge between two free flowers or a loop of a blue flower.
+	void separateEdge(Edge *edge);
+	// Lowers the powers of the flowers containing the blue flower by the given sum, starting with its outer flower.
+	void lowerContainingPowers(Flower *blueFlower, Weight decrease);
+	void splitDumbbell(Flower *dumbbellFlower);
+	void dissolveFlower(Flower *rootFlower);
+#ifdef ENABLE_INTEGER_WEIGHTS
+	// Lowers the powers of the exposed roots, so that the paddings between all trees stay even.
+	void equalizeRootParity();
+#endif
+};
+
+#endif // EDMONDS_ALGORITHM_MATCHING_SOLVER_H
\ No newline at end of file
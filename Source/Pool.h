@@ -0,0 +1,195 @@
+#ifndef EDMONDS_ALGORITHM_POOL_H
+#define EDMONDS_ALGORITHM_POOL_H
+
+#include "Utility.h"
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Objects per block of an indexed pool. The block table of ten million objects still fits within the first level cache.
+#define INDEXED_POOL_BLOCK_SHIFT 12
+#define INDEXED_POOL_BLOCK_SIZE (1 << INDEXED_POOL_BLOCK_SHIFT)
+
+// Allocates objects from contiguous blocks instead of one heap allocation per object.
+// Destroyed objects leave their slot to be recycled by the next created object.
+// Objects never move, so pointers to them stay valid until they are destroyed or the pool is cleared.
+template <typename T>
+class Pool
+{
+public:
+	explicit Pool(int blockSize = 1024)
+	: blockSize(blockSize)
+	{}
+
+	~Pool()
+	{
+		this->clear();
+	}
+
+	// Ensures that the next count objects are created within a single block.
+	void reserve(int count)
+	{
+		if (this->blocks.empty() || (static_cast<int>(this->blocks.back().capacity() - this->blocks.back().size()) < count)) {
+			this->addBlock(count);
+		}
+	}
+
+	T *create()
+	{
+		if (!this->freeItems.empty()) {
+			T *item(this->freeItems.back());
+			this->freeItems.pop_back();
+			new (item) T();
+			return item;
+		}
+
+		if (this->blocks.empty() || (this->blocks.back().size() == this->blocks.back().capacity())) {
+			this->addBlock(this->blockSize);
+		}
+
+		std::vector<T> &block(this->blocks.back());
+		block.emplace_back();
+		return &block.back();
+	}
+
+	void destroy(T *item)
+	{
+		item->~T();
+		this->freeItems.push_back(item);
+	}
+
+	// Destroys all objects, but keeps their memory for the next objects.
+	// The blocks are merged into one, so that as many objects as before can be created without an allocation.
+	void reset()
+	{
+		this->reviveFreeItems();
+
+		std::size_t capacity(0);
+		for (typename std::vector<std::vector<T>>::iterator blockIt(this->blocks.begin()), blockEnd(this->blocks.end());
+			blockIt != blockEnd; ++blockIt) {
+			capacity += blockIt->capacity();
+		}
+
+		if (this->blocks.size() > 1) {
+			this->blocks.clear();
+			this->addBlock(static_cast<int>(capacity));
+		} else if (!this->blocks.empty()) {
+			this->blocks.back().clear();
+		}
+	}
+
+	// Destroys all objects and releases all blocks.
+	void clear()
+	{
+		this->reviveFreeItems();
+		this->blocks.clear();
+	}
+
+	// Returns the number of bytes held by the blocks.
+	std::size_t capacityBytes() const
+	{
+		std::size_t capacity(0);
+		for (typename std::vector<std::vector<T>>::const_iterator blockIt(this->blocks.cbegin()), blockEnd(this->blocks.cend());
+			blockIt != blockEnd; ++blockIt) {
+			capacity += blockIt->capacity();
+		}
+		return capacity * sizeof(T) + this->freeItems.capacity() * sizeof(T *);
+	}
+
+private:
+	std::vector<std::vector<T>> blocks;
+	std::vector<T *> freeItems;
+	int blockSize;
+
+	// Recycled slots hold already destroyed objects, which the blocks would destroy again.
+	void reviveFreeItems()
+	{
+		for (typename std::vector<T *>::iterator itemIt(this->freeItems.begin()), itemEnd(this->freeItems.end());
+			itemIt != itemEnd; ++itemIt) {
+			new (*itemIt) T();
+		}
+		this->freeItems.clear();
+	}
+
+	void addBlock(int capacity)
+	{
+		this->blocks.emplace_back();
+		this->blocks.back().reserve(capacity);
+	}
+};
+
+// Creates objects in order within blocks of a fixed power of two size, so that the object of an index
+// is found by a shift and a mask, and 32-bit indices can stand in for pointers.
+// Objects never move, so pointers to them stay valid until the pool is reset or cleared.
+template <typename T>
+class IndexedPool
+{
+public:
+	IndexedPool()
+	: itemCount(0)
+	{}
+
+	~IndexedPool()
+	{
+		this->clear();
+	}
+
+	// Creates the object of the next index.
+	T *create()
+	{
+		int blockIndex(this->itemCount >> INDEXED_POOL_BLOCK_SHIFT);
+		if (blockIndex == static_cast<int>(this->blocks.size())) {
+			this->blocks.emplace_back();
+			this->blocks.back().reserve(INDEXED_POOL_BLOCK_SIZE);
+			this->blockItems.push_back(this->blocks.back().data());
+		}
+		++this->itemCount;
+
+		std::vector<T> &block(this->blocks[blockIndex]);
+		block.emplace_back();
+		return &block.back();
+	}
+
+	T *at(int index) const
+	{
+		return this->blockItems[index >> INDEXED_POOL_BLOCK_SHIFT] + (index & (INDEXED_POOL_BLOCK_SIZE - 1));
+	}
+
+	int size() const
+	{
+		return this->itemCount;
+	}
+
+	// Destroys all objects, but keeps their blocks for the next objects.
+	void reset()
+	{
+		for (typename std::vector<std::vector<T>>::iterator blockIt(this->blocks.begin()), blockEnd(this->blocks.end());
+			blockIt != blockEnd; ++blockIt) {
+			blockIt->clear();
+		}
+		this->itemCount = 0;
+	}
+
+	// Destroys all objects and releases all blocks.
+	void clear()
+	{
+		this->blocks.clear();
+		this->blockItems.clear();
+		this->itemCount = 0;
+	}
+
+	// Returns the number of bytes held by the blocks.
+	std::size_t capacityBytes() const
+	{
+		return this->blocks.size() * INDEXED_POOL_BLOCK_SIZE * sizeof(T) + this->blockItems.capacity() * sizeof(T *);
+	}
+
+private:
+	std::vector<std::vector<T>> blocks;
+	// First object of each block, so that finding an object reads a single pointer.
+	std::vector<T *> blockItems;
+	int itemCount;
+};
+
+#endif // EDMONDS_ALGORITHM_POOL_H
\ No newline at end of file
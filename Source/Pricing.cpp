@@ -0,0 +1,222 @@
+#include "Pricing.h"
+
+#include "Loader.h"
+#include "MatchingSolver.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+PricingStatistics::PricingStatistics()
+: roundCount(0)
+, candidateEdgeCount(0)
+, addedEdgeCount(0)
+, pricedEdgeCount(0)
+{}
+
+// Edges of the priced graph, which are either listed or implied by coordinates, and which of them the solver has.
+class PricedGraph
+{
+public:
+	explicit PricedGraph(const InputGraph &graph)
+	: graph(graph)
+	{}
+
+	// Copies the given number of lightest edges at each vertex into the candidate graph, which the solver gets.
+	void selectCandidateEdges(int candidateCount, InputGraph &candidateGraph)
+	{
+		candidateGraph.vertexCount = this->graph.vertexCount;
+		if (this->graph.isImplicit()) {
+			this->selectImplicitCandidateEdges(candidateCount, candidateGraph);
+		} else {
+			this->selectListedCandidateEdges(candidateCount, candidateGraph);
+		}
+	}
+
+	// Collects the edges that the solver does not have yet and that satisfy the predicate, which the solver then gets.
+	// The predicate takes both vertices counted from zero and the weight.
+	// Edges of an implicit graph are only looked up afterwards, so the predicate may also see edges of the solver.
+	template <typename Predicate>
+	void collectEdges(Predicate isNeeded, std::vector<InputEdge> &neededEdges)
+	{
+		if (this->graph.isImplicit()) {
+			for (int i(0); i < this->graph.vertexCount; ++i) {
+				for (int j(i + 1); j < this->graph.vertexCount; ++j) {
+					double weight(this->graph.implicitWeight(i, j));
+					if (isNeeded(i, j, weight) && this->solverPairs.insert(this->pairKey(i, j)).second) {
+						appendEdge(i, j, weight, neededEdges);
+					}
+				}
+			}
+			return;
+		}
+
+		// A loop is never paired and the solver does not take added loops, so they are left out.
+		for (int i(0), count(static_cast<int>(this->graph.edges.size())); i < count; ++i) {
+			const InputEdge &inputEdge(this->graph.edges[i]);
+			bool isLoop(inputEdge.vertexIds[0] == inputEdge.vertexIds[1]);
+			if (!this->isSolverEdge[i] && !isLoop && isNeeded(inputEdge.vertexIds[0] - 1, inputEdge.vertexIds[1] - 1, inputEdge.weight)) {
+				this->isSolverEdge[i] = true;
+				neededEdges.push_back(inputEdge);
+			}
+		}
+	}
+
+private:
+	const InputGraph &graph;
+	// Listed edges that the solver has, by their index.
+	std::vector<bool> isSolverEdge;
+	// Vertex pairs of an implicit graph that the solver has, see pairKey.
+	std::unordered_set<long long> solverPairs;
+
+	long long pairKey(int vertexA, int vertexB) const
+	{
+		return static_cast<long long>(std::min(vertexA, vertexB)) * this->graph.vertexCount + std::max(vertexA, vertexB);
+	}
+
+	static void appendEdge(int vertexA, int vertexB, double weight, std::vector<InputEdge> &edges)
+	{
+		InputEdge edge;
+		edge.vertexIds[0] = vertexA + 1;
+		edge.vertexIds[1] = vertexB + 1;
+		edge.weight = weight;
+		edges.push_back(edge);
+	}
+
+	void selectListedCandidateEdges(int candidateCount, InputGraph &candidateGraph)
+	{
+		int vertexCount(this->graph.vertexCount);
+		int edgeCount(static_cast<int>(this->graph.edges.size()));
+
+		// Group the edges by their vertices, each vertex owning a contiguous slice.
+		std::vector<int> incidentOffsets(vertexCount + 1, 0);
+		STD_VECTOR_CONST_FOREACH_(InputEdge, this->graph.edges, edgeIt, edgeEnd) {
+			for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+				++incidentOffsets[edgeIt->vertexIds[i]];
+			}
+		}
+		for (int i(0); i < vertexCount; ++i) {
+			incidentOffsets[i + 1] += incidentOffsets[i];
+		}
+		std::vector<int> incidentEdges(incidentOffsets[vertexCount]);
+		std::vector<int> incidentPositions(incidentOffsets.begin(), incidentOffsets.end() - 1);
+		for (int i(0); i < edgeCount; ++i) {
+			for (int j(0); j < VERTEX_PER_EDGE_COUNT; ++j) {
+				incidentEdges[incidentPositions[this->graph.edges[i].vertexIds[j] - 1]++] = i;
+			}
+		}
+
+		const std::vector<InputEdge> &edges(this->graph.edges);
+		this->isSolverEdge.assign(edgeCount, false);
+		for (int i(0); i < vertexCount; ++i) {
+			std::vector<int>::iterator sliceBegin(incidentEdges.begin() + incidentOffsets[i]);
+			std::vector<int>::iterator sliceEnd(incidentEdges.begin() + incidentOffsets[i + 1]);
+			std::vector<int>::iterator candidateEnd(sliceBegin + std::min(candidateCount, static_cast<int>(sliceEnd - sliceBegin)));
+			std::nth_element(sliceBegin, candidateEnd, sliceEnd, [&edges](int edgeA, int edgeB) {
+				return edges[edgeA].weight < edges[edgeB].weight;
+			});
+			for (std::vector<int>::iterator edgeIt(sliceBegin); edgeIt != candidateEnd; ++edgeIt) {
+				this->isSolverEdge[*edgeIt] = true;
+			}
+		}
+
+		for (int i(0); i < edgeCount; ++i) {
+			if (this->isSolverEdge[i]) {
+				candidateGraph.edges.push_back(edges[i]);
+			}
+		}
+	}
+
+	// Only the weights of one vertex are held at a time, so the memory stays linear in the vertex count.
+	void selectImplicitCandidateEdges(int candidateCount, InputGraph &candidateGraph)
+	{
+		int vertexCount(this->graph.vertexCount);
+		std::vector<std::pair<double, int>> weights;
+		for (int i(0); i < vertexCount; ++i) {
+			weights.clear();
+			for (int j(0); j < vertexCount; ++j) {
+				if (j != i) {
+					weights.push_back(std::make_pair(this->graph.implicitWeight(i, j), j));
+				}
+			}
+			std::vector<std::pair<double, int>>::iterator candidateEnd(
+				weights.begin() + std::min(candidateCount, static_cast<int>(weights.size())));
+			std::nth_element(weights.begin(), candidateEnd, weights.end());
+			for (std::vector<std::pair<double, int>>::iterator weightIt(weights.begin()); weightIt != candidateEnd; ++weightIt) {
+				if (this->solverPairs.insert(this->pairKey(i, weightIt->second)).second) {
+					appendEdge(std::min(i, weightIt->second), std::max(i, weightIt->second), weightIt->first, candidateGraph.edges);
+				}
+			}
+		}
+	}
+};
+
+bool solveWithPricing(InputGraph &&graph, int candidateCount, MatchingSolver &solver, bool &isPerfect,
+	PricingStatistics &statistics, const char *&errorMessage)
+{
+	statistics = PricingStatistics();
+
+	// The solver takes the candidate edges, while the whole graph is kept for pricing.
+	PricedGraph pricedGraph(graph);
+	{
+		InputGraph candidateGraph;
+		pricedGraph.selectCandidateEdges(candidateCount, candidateGraph);
+		statistics.candidateEdgeCount = static_cast<long long>(candidateGraph.edges.size());
+		if (!solver.setGraph(std::move(candidateGraph), errorMessage)) {
+			return false;
+		}
+	}
+
+	isPerfect = solver.solve();
+	++statistics.roundCount;
+
+	std::vector<double> powerSums;
+	std::vector<InputEdge> neededEdges;
+	FOREVER {
+		neededEdges.clear();
+
+		if (isPerfect) {
+			// The pairing is optimal for the whole graph if no other edge has a negative padding.
+			// Most edges are ruled out by the power sums of their vertices, without a walk through the flowers.
+			powerSums.resize(graph.vertexCount);
+			for (int i(0); i < graph.vertexCount; ++i) {
+				powerSums[i] = solver.vertexPowerSum(i);
+			}
+			pricedGraph.collectEdges([&](int vertexA, int vertexB, double weight) {
+				if (weight >= powerSums[vertexA] + powerSums[vertexB]) {
+					return false;
+				}
+				++statistics.pricedEdgeCount;
+				return solver.edgePadding(vertexA, vertexB, weight) < 0;
+			}, neededEdges);
+		} else {
+			// Give the unpaired vertices all their edges, or give up on the candidates if they already have them.
+			pricedGraph.collectEdges([&solver](int vertexA, int vertexB, double) {
+				return (solver.mate(vertexA) < 0) || (solver.mate(vertexB) < 0);
+			}, neededEdges);
+			if (neededEdges.empty()) {
+				pricedGraph.collectEdges([](int, int, double) {
+					return true;
+				}, neededEdges);
+			}
+		}
+
+		if (neededEdges.empty()) {
+			break;
+		}
+
+		STD_VECTOR_CONST_FOREACH_(InputEdge, neededEdges, edgeIt, edgeEnd) {
+			if (!solver.addEdge(edgeIt->vertexIds[0] - 1, edgeIt->vertexIds[1] - 1, edgeIt->weight, errorMessage)) {
+				return false;
+			}
+		}
+		statistics.addedEdgeCount += static_cast<long long>(neededEdges.size());
+
+		isPerfect = solver.resolve();
+		++statistics.roundCount;
+	}
+
+	return true;
+}
\ No newline at end of file
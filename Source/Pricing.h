@@ -0,0 +1,32 @@
+#ifndef EDMONDS_ALGORITHM_PRICING_H
+#define EDMONDS_ALGORITHM_PRICING_H
+
+#include "Loader.h"
+#include "MatchingSolver.h"
+
+// Counts of the work done by the last solve with pricing.
+struct PricingStatistics
+{
+	// Solves and resolves that were needed, including the first solve on the candidate edges.
+	int roundCount;
+	// Edges given to the first solve.
+	long long candidateEdgeCount;
+	// Edges added afterwards, because their padding was negative or a perfect pairing was missing.
+	long long addedEdgeCount;
+	// Edges whose padding was computed by a walk through the flowers, because the power sums of their vertices allowed a negative one.
+	long long pricedEdgeCount;
+
+	PricingStatistics();
+};
+
+// Solves the graph on the given number of lightest edges at each vertex first,
+// then adds the other edges whose padding is negative under the found powers and continues,
+// until the powers are feasible for every edge, which makes the pairing optimal for the whole graph.
+// If the candidate edges have no perfect pairing, the edges of the unpaired vertices are added,
+// and if that does not help, all remaining edges are added.
+// An implicit complete graph is never listed, only the edges that the solver gets exist.
+// On failure an error message is stored and false is returned. Otherwise isPerfect tells whether a perfect pairing exists.
+bool solveWithPricing(InputGraph &&graph, int candidateCount, MatchingSolver &solver, bool &isPerfect,
+	PricingStatistics &statistics, const char *&errorMessage);
+
+#endif // EDMONDS_ALGORITHM_PRICING_H
\ No newline at end of file
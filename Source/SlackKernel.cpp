@@ -0,0 +1,63 @@
+#include "SlackKernel.h"
+
+#include "Utility.h"
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+void SlackTable::clear()
+{
+	this->paddings.clear();
+	this->incrementableCounts.clear();
+}
+
+void SlackTable::push(Weight padding, int incrementableCount)
+{
+	this->paddings.push_back(padding);
+	this->incrementableCounts.push_back(static_cast<signed char>(incrementableCount));
+}
+
+void SlackTable::resize(int size)
+{
+	this->paddings.resize(size);
+	this->incrementableCounts.resize(size);
+}
+
+void SlackTable::set(int index, Weight padding, int incrementableCount)
+{
+	this->paddings[index] = padding;
+	this->incrementableCounts[index] = static_cast<signed char>(incrementableCount);
+}
+
+int SlackTable::size() const
+{
+	return static_cast<int>(this->paddings.size());
+}
+
+std::size_t SlackTable::capacityBytes() const
+{
+	return this->paddings.capacity() * sizeof(Weight) + this->incrementableCounts.capacity() * sizeof(signed char);
+}
+
+int findMinEpsilonIndex(const SlackTable &slackTable, Weight &minEpsilon)
+{
+	return findMinEpsilonIndex(slackTable, 0, slackTable.size(), minEpsilon);
+}
+
+int findMinEpsilonIndex(const SlackTable &slackTable, int begin, int end, Weight &minEpsilon)
+{
+	minEpsilon = std::numeric_limits<Weight>::max();
+	int minIndex(-1);
+	for (int i(begin); i < end; ++i) {
+		int incrementableCount(slackTable.incrementableCounts[i]);
+		if (incrementableCount > 0) {
+			Weight epsilon(slackTable.paddings[i] / incrementableCount);
+			if (epsilon < minEpsilon) {
+				minEpsilon = epsilon;
+				minIndex = i;
+			}
+		}
+	}
+	return minIndex;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef EDMONDS_ALGORITHM_SLACK_KERNEL_H
+#define EDMONDS_ALGORITHM_SLACK_KERNEL_H
+
+#include "Utility.h"
+
+#include <cstddef>
+#include <vector>
+
+// Paddings of scanned edges and the numbers of their incrementable flowers, kept in separate dense arrays,
+// so that the search for the minimum epsilon streams through them.
+class SlackTable
+{
+public:
+	std::vector<Weight> paddings;
+	std::vector<signed char> incrementableCounts;
+
+	void clear();
+	void push(Weight padding, int incrementableCount);
+
+	// Makes room for the given number of entries, so that they can be set from several threads.
+	void resize(int size);
+	void set(int index, Weight padding, int incrementableCount);
+
+	int size() const;
+
+	// Returns the number of bytes held by both arrays.
+	std::size_t capacityBytes() const;
+};
+
+// Returns the index of the first entry with the smallest epsilon, which is the padding divided by the number
+// of incrementable flowers. Entries without incrementable flowers are skipped. Returns -1 if no entry remains.
+int findMinEpsilonIndex(const SlackTable &slackTable, Weight &minEpsilon);
+
+// Same as findMinEpsilonIndex, but only searches the entries in [begin, end).
+int findMinEpsilonIndex(const SlackTable &slackTable, int begin, int end, Weight &minEpsilon);
+
+#endif // EDMONDS_ALGORITHM_SLACK_KERNEL_H
\ No newline at end of file
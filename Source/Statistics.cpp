@@ -0,0 +1,185 @@
+#include "Statistics.h"
+
+#include <chrono>
+#include <csignal>
+#include <ios>
+#include <ostream>
+
+volatile std::sig_atomic_t isStatisticsDumpRequested(0);
+
+const char *phaseName(Phase phase)
+{
+	switch (phase) {
+	case Phase::CREATE_FLOWERS_AND_EDGES:
+		return "createFlowersAndEdges";
+	case Phase::WARM_START:
+		return "executeWarmStart";
+	case Phase::INITIALIZE_QUEUE:
+		return "initializeQueue";
+	case Phase::REFRESH_QUEUE:
+		return "refreshTouchedFlowers";
+	case Phase::FIND_MIN_EDGE_EPSILON:
+		return "findMinEdgeEpsilon";
+	case Phase::FIND_MIN_GREEN_FLOWER_EPSILON:
+		return "findMinGreenFlowerEpsilon";
+	case Phase::COLLECT_EVENTS:
+		return "findMinEvents";
+	case Phase::APPLY_EPSILON:
+		return "applyEpsilon";
+	case Phase::BURST_FLOWER:
+		return "executeBurstFlower";
+	case Phase::APPEND_DUMBBELL:
+		return "executeAppendDumbbell";
+	case Phase::CREATE_FLOWER:
+		return "executeCreateFlower";
+	case Phase::COLLAPSE_TREE:
+		return "executeCollapseTree";
+	case Phase::COLLECT_PAIRING:
+		return "collectPairing";
+	}
+	return "";
+}
+
+SolverStatistics::SolverStatistics()
+: isOn(false)
+{
+	this->clear();
+}
+
+void SolverStatistics::clear()
+{
+	this->iterationCount = 0;
+	this->scannedEdgeCount = 0;
+	this->blossomCount = 0;
+	this->peakFlowerCount = 0;
+	this->maxNestingDepth = 0;
+	this->edgeCount = 0;
+	this->memoryBytes = 0;
+	for (int i(0); i < PHASE_COUNT; ++i) {
+		this->phases[i].callCount = 0;
+		this->phases[i].seconds = 0;
+	}
+}
+
+void SolverStatistics::setEnabled(bool isEnabled)
+{
+	this->isOn = isEnabled;
+}
+
+bool SolverStatistics::isEnabled() const
+{
+	return this->isOn;
+}
+
+const PhaseStatistics &SolverStatistics::phase(Phase phase) const
+{
+	return this->phases[static_cast<int>(phase)];
+}
+
+void SolverStatistics::addCall(Phase phase, double seconds)
+{
+	PhaseStatistics &phaseStatistics(this->phases[static_cast<int>(phase)]);
+	++phaseStatistics.callCount;
+	phaseStatistics.seconds += seconds;
+}
+
+void SolverStatistics::add(const SolverStatistics &statistics)
+{
+	this->iterationCount += statistics.iterationCount;
+	this->scannedEdgeCount += statistics.scannedEdgeCount;
+	this->blossomCount += statistics.blossomCount;
+	this->edgeCount += statistics.edgeCount;
+	this->memoryBytes += statistics.memoryBytes;
+	if (statistics.peakFlowerCount > this->peakFlowerCount) {
+		this->peakFlowerCount = statistics.peakFlowerCount;
+	}
+	if (statistics.maxNestingDepth > this->maxNestingDepth) {
+		this->maxNestingDepth = statistics.maxNestingDepth;
+	}
+	for (int i(0); i < PHASE_COUNT; ++i) {
+		this->phases[i].callCount += statistics.phases[i].callCount;
+		this->phases[i].seconds += statistics.phases[i].seconds;
+	}
+}
+
+double SolverStatistics::scanSeconds() const
+{
+	return this->phase(Phase::INITIALIZE_QUEUE).seconds + this->phase(Phase::REFRESH_QUEUE).seconds
+		+ this->phase(Phase::FIND_MIN_EDGE_EPSILON).seconds + this->phase(Phase::FIND_MIN_GREEN_FLOWER_EPSILON).seconds
+		+ this->phase(Phase::COLLECT_EVENTS).seconds;
+}
+
+double SolverStatistics::actionSeconds() const
+{
+	return this->phase(Phase::BURST_FLOWER).seconds + this->phase(Phase::APPEND_DUMBBELL).seconds
+		+ this->phase(Phase::CREATE_FLOWER).seconds + this->phase(Phase::COLLAPSE_TREE).seconds;
+}
+
+double SolverStatistics::bytesPerEdge() const
+{
+	return (this->edgeCount > 0) ? static_cast<double>(this->memoryBytes) / this->edgeCount : 0.0;
+}
+
+void SolverStatistics::writeJson(std::ostream &stream) const
+{
+	std::ios::fmtflags flags(stream.flags());
+	std::streamsize precision(stream.precision());
+	stream.setf(std::ios::fixed, std::ios::floatfield);
+	stream.precision(6);
+
+	stream << "{\"iterations\":" << this->iterationCount
+		<< ",\"events\":{\"P1\":" << this->phase(Phase::BURST_FLOWER).callCount
+		<< ",\"P2\":" << this->phase(Phase::APPEND_DUMBBELL).callCount
+		<< ",\"P3\":" << this->phase(Phase::CREATE_FLOWER).callCount
+		<< ",\"P4\":" << this->phase(Phase::COLLAPSE_TREE).callCount << "}"
+		<< ",\"scannedEdges\":" << this->scannedEdgeCount
+		<< ",\"blossoms\":" << this->blossomCount
+		<< ",\"peakFlowers\":" << this->peakFlowerCount
+		<< ",\"maxNestingDepth\":" << this->maxNestingDepth
+		<< ",\"memoryBytes\":" << this->memoryBytes
+		<< ",\"bytesPerEdge\":" << this->bytesPerEdge()
+		<< ",\"scanSeconds\":" << this->scanSeconds()
+		<< ",\"actionSeconds\":" << this->actionSeconds()
+		<< ",\"phases\":{";
+	for (int i(0); i < PHASE_COUNT; ++i) {
+		const PhaseStatistics &phaseStatistics(this->phases[i]);
+		stream << ((i > 0) ? "," : "") << "\"" << phaseName(static_cast<Phase>(i)) << "\":{\"calls\":"
+			<< phaseStatistics.callCount << ",\"seconds\":" << phaseStatistics.seconds << "}";
+	}
+	stream << "}}";
+
+	stream.flags(flags);
+	stream.precision(precision);
+}
+
+void requestStatisticsDump()
+{
+	isStatisticsDumpRequested = 1;
+}
+
+bool takeStatisticsDumpRequest()
+{
+	if (isStatisticsDumpRequested == 0) {
+		return false;
+	}
+	isStatisticsDumpRequested = 0;
+	return true;
+}
+
+PhaseTimer::PhaseTimer(SolverStatistics &statistics, Phase phase)
+: statistics(statistics)
+, phase(phase)
+{
+	if (statistics.isEnabled()) {
+		this->start = std::chrono::steady_clock::now();
+	}
+}
+
+PhaseTimer::~PhaseTimer()
+{
+	double seconds(0);
+	if (this->statistics.isEnabled()) {
+		seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start).count();
+	}
+	this->statistics.addCall(this->phase, seconds);
+}
\ No newline at end of file
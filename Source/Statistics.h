@@ -0,0 +1,113 @@
+#ifndef EDMONDS_ALGORITHM_STATISTICS_H
+#define EDMONDS_ALGORITHM_STATISTICS_H
+
+#include <chrono>
+#include <ostream>
+
+// Phases of a solve, each of which is counted and optionally timed.
+enum class Phase : char
+{
+	CREATE_FLOWERS_AND_EDGES,
+	WARM_START,
+	INITIALIZE_QUEUE,
+	REFRESH_QUEUE,
+	FIND_MIN_EDGE_EPSILON,
+	FIND_MIN_GREEN_FLOWER_EPSILON,
+	COLLECT_EVENTS,
+	APPLY_EPSILON,
+	BURST_FLOWER,
+	APPEND_DUMBBELL,
+	CREATE_FLOWER,
+	COLLAPSE_TREE,
+	COLLECT_PAIRING
+};
+
+#define PHASE_COUNT 13
+
+// Returns the name of the function that implements the phase.
+const char *phaseName(Phase phase);
+
+struct PhaseStatistics
+{
+	long long callCount;
+	double seconds;
+};
+
+// Counts of the work done by the last solve.
+// Counters and the nesting depth are always kept, as each costs one increment or comparison.
+// The phase times need the clock, so they are only measured while the statistics are enabled.
+class SolverStatistics
+{
+public:
+	// Iterations of the core loop, each of which applies one epsilon value.
+	long long iterationCount;
+
+	// Edges whose padding has been computed, either when requeued or by a full scan.
+	long long scannedEdgeCount;
+
+	// Green flowers at the end of the run.
+	int blossomCount;
+
+	// The most flowers of both colors that existed at once.
+	int peakFlowerCount;
+
+	// The most green flowers that contained one blue flower at once.
+	int maxNestingDepth;
+
+	// Edges of the solved graph, removed ones included.
+	long long edgeCount;
+
+	// Bytes held by the graph, the flowers, the edges and the queues at the end of the run,
+	// measured from the capacities of their arrays.
+	long long memoryBytes;
+
+	SolverStatistics();
+
+	void clear();
+
+	void setEnabled(bool isEnabled);
+	bool isEnabled() const;
+
+	const PhaseStatistics &phase(Phase phase) const;
+
+	void addCall(Phase phase, double seconds);
+
+	// Adds the counters and times of another solve, while the peaks become the larger of both.
+	void add(const SolverStatistics &statistics);
+
+	// Time spent finding events, which includes requeueing the edges of touched flowers.
+	double scanSeconds() const;
+	// Time spent in the actions (P1) to (P4).
+	double actionSeconds() const;
+
+	double bytesPerEdge() const;
+
+	// Writes all values as one JSON object on a single line.
+	void writeJson(std::ostream &stream) const;
+
+private:
+	PhaseStatistics phases[PHASE_COUNT];
+	bool isOn;
+};
+
+// Asks the running solve to write its statistics to the standard error output after the current iteration.
+// Only sets a flag, so it may be called from a signal handler.
+void requestStatisticsDump();
+
+// Returns whether a dump has been requested since the last call.
+bool takeStatisticsDumpRequest();
+
+// Counts one call of a phase and measures its time from the construction to the destruction of the timer.
+class PhaseTimer
+{
+public:
+	PhaseTimer(SolverStatistics &statistics, Phase phase);
+	~PhaseTimer();
+
+private:
+	SolverStatistics &statistics;
+	Phase phase;
+	std::chrono::steady_clock::time_point start;
+};
+
+#endif // EDMONDS_ALGORITHM_STATISTICS_H
\ No newline at end of file
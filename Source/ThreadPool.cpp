@@ -0,0 +1,140 @@
+#include "ThreadPool.h"
+
+#include "Utility.h"
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+ThreadPool::ThreadPool(int threadCount)
+: task(nullptr)
+, taskCount(0)
+, generation(0)
+, pendingWorkerCount(0)
+, isStopping(false)
+{
+	// Chunk zero is always run by the calling thread.
+	for (int i(1); i < threadCount; ++i) {
+		this->workers.emplace_back(&ThreadPool::work, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->isStopping = true;
+	}
+	this->workAvailable.notify_all();
+	for (std::vector<std::thread>::iterator workerIt(this->workers.begin()), workerEnd(this->workers.end());
+		workerIt != workerEnd; ++workerIt) {
+		workerIt->join();
+	}
+}
+
+int ThreadPool::threadCount() const
+{
+	return static_cast<int>(this->workers.size()) + 1;
+}
+
+int ThreadPool::chunkBegin(int count, int chunkIndex) const
+{
+	return static_cast<int>(static_cast<long long>(count) * chunkIndex / this->threadCount());
+}
+
+void ThreadPool::run(int count, const std::function<void(int, int, int)> &task)
+{
+	if (this->workers.empty()) {
+		task(0, 0, count);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->task = &task;
+		this->taskCount = count;
+		this->pendingWorkerCount = static_cast<int>(this->workers.size());
+		++this->generation;
+	}
+	this->workAvailable.notify_all();
+
+	task(0, 0, this->chunkBegin(count, 1));
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+	this->workDone.wait(lock, [this]() { return this->pendingWorkerCount == 0; });
+	this->task = nullptr;
+}
+
+void ThreadPool::runStealing(int count, const std::function<void(int, int)> &task)
+{
+	std::vector<StealableRange> ranges(this->threadCount());
+	for (int i(0); i < this->threadCount(); ++i) {
+		ranges[i].next = this->chunkBegin(count, i);
+		ranges[i].end = this->chunkBegin(count, i + 1);
+	}
+
+	// Chunks only shrink, so a chunk found empty once stays empty.
+	this->run(this->threadCount(), [this, &ranges, &task](int threadIndex, int, int) {
+		int index(0);
+		while (ranges[threadIndex].takeFront(index)) {
+			task(threadIndex, index);
+		}
+		for (int i(1); i < this->threadCount(); ++i) {
+			StealableRange &range(ranges[(threadIndex + i) % this->threadCount()]);
+			while (range.takeBack(index)) {
+				task(threadIndex, index);
+			}
+		}
+	});
+}
+
+bool ThreadPool::StealableRange::takeFront(int &index)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (this->next == this->end) {
+		return false;
+	}
+	index = this->next++;
+	return true;
+}
+
+bool ThreadPool::StealableRange::takeBack(int &index)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	if (this->next == this->end) {
+		return false;
+	}
+	index = --this->end;
+	return true;
+}
+
+void ThreadPool::work(int chunkIndex)
+{
+	int finishedGeneration(0);
+	FOREVER {
+		const std::function<void(int, int, int)> *currentTask(nullptr);
+		int count(0);
+		{
+			std::unique_lock<std::mutex> lock(this->mutex);
+			this->workAvailable.wait(lock, [this, finishedGeneration]() {
+				return this->isStopping || (this->generation != finishedGeneration);
+			});
+			if (this->isStopping) {
+				return;
+			}
+			finishedGeneration = this->generation;
+			currentTask = this->task;
+			count = this->taskCount;
+		}
+
+		(*currentTask)(chunkIndex, this->chunkBegin(count, chunkIndex), this->chunkBegin(count, chunkIndex + 1));
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			--this->pendingWorkerCount;
+		}
+		this->workDone.notify_one();
+	}
+}
\ No newline at end of file
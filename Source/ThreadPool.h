@@ -0,0 +1,61 @@
+#ifndef EDMONDS_ALGORITHM_THREAD_POOL_H
+#define EDMONDS_ALGORITHM_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run a task over a range split into contiguous chunks.
+// The split depends only on the range size and the thread count, so that results reduced chunk by chunk
+// are the same in every run.
+class ThreadPool
+{
+public:
+	// The calling thread is counted as one of the threads.
+	explicit ThreadPool(int threadCount);
+	~ThreadPool();
+
+	int threadCount() const;
+
+	// Splits [0, count) into one chunk per thread and calls task(chunkIndex, begin, end) for every chunk.
+	// Returns once all chunks are done.
+	void run(int count, const std::function<void(int, int, int)> &task);
+
+	// Calls task(threadIndex, index) for every index of [0, count), each thread starting with its own chunk.
+	// Threads that are done with their chunk steal the remaining indices of the other chunks one by one from their ends,
+	// so that tasks of very different lengths still keep all threads busy. Returns once all indices are done.
+	void runStealing(int count, const std::function<void(int, int)> &task);
+
+	// Returns the first index of the chunk for a range of the given size.
+	int chunkBegin(int count, int chunkIndex) const;
+
+private:
+	// Indices of a chunk that are not taken yet.
+	struct StealableRange
+	{
+		std::mutex mutex;
+		int next;
+		int end;
+
+		bool takeFront(int &index);
+		bool takeBack(int &index);
+	};
+
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable workAvailable;
+	std::condition_variable workDone;
+
+	const std::function<void(int, int, int)> *task;
+	int taskCount;
+	int generation;
+	int pendingWorkerCount;
+	bool isStopping;
+
+	void work(int chunkIndex);
+};
+
+#endif // EDMONDS_ALGORITHM_THREAD_POOL_H
\ No newline at end of file
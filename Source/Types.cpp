@@ -5,12 +5,74 @@
 #include <vector>
 #include <iostream>
 
+EdgeRange::EdgeRange()
+: first(nullptr)
+, last(nullptr)
+, edgePool(nullptr)
+{}
+
+EdgeRange::EdgeRange(const int *first, const int *last, const IndexedPool<Edge> *edgePool)
+: first(first)
+, last(last)
+, edgePool(edgePool)
+{}
+
+EdgeRange::iterator EdgeRange::begin() const
+{
+	return iterator(this->first, this->edgePool);
+}
+
+EdgeRange::iterator EdgeRange::end() const
+{
+	return iterator(this->last, this->edgePool);
+}
+
+bool EdgeRange::empty() const
+{
+	return this->first == this->last;
+}
+
+const int *EdgeRange::firstIndex() const
+{
+	return this->first;
+}
+
+const int *EdgeRange::lastIndex() const
+{
+	return this->last;
+}
+
+int dualOffsetFactor(Flower::Type type)
+{
+	switch (type) {
+	case Flower::Type::EVEN_IN_TREE:
+		return 1;
+	case Flower::Type::ODD_IN_TREE:
+		return -1;
+	default:
+		return 0;
+	}
+}
+
 Flower::Flower()
 : type(Type::EVEN_IN_TREE)
-, power(0.0)
-, parent(nullptr)
+, stampedPower(0)
 , stemSubFlower(nullptr)
+, cycleIndex(-1)
+, parent(nullptr)
+, parentEdge(nullptr)
+, pairingEdge(nullptr)
+, enclosingFlower(nullptr)
+, nestingHeight(0)
+, firstBlueFlower(this)
+, lastBlueFlower(this)
+, followingBlueFlower(nullptr)
+, treeId(-1)
 , vertexId(0)
+, queuePosition(-1)
+, chainStamp(0)
+, chainOuterFlower(nullptr)
+, chainPower(0)
 {}
 
 bool Flower::isInDumbbell() const
@@ -28,46 +90,103 @@ bool Flower::isGreen() const
 	return this->stemSubFlower != nullptr;
 }
 
-Flower *Flower::root()
+Weight Flower::power(Weight dualOffset) const
+{
+	return this->stampedPower + dualOffsetFactor(this->type) * dualOffset;
+}
+
+void Flower::setPower(Weight power, Weight dualOffset)
+{
+	this->stampedPower = power - dualOffsetFactor(this->type) * dualOffset;
+}
+
+void Flower::setType(Type type, Weight dualOffset)
 {
-	Flower *currentFlower(this);
-	while (currentFlower->parent != nullptr) {
-		currentFlower = currentFlower->parent;
+	Weight currentPower(this->power(dualOffset));
+	this->type = type;
+	this->setPower(currentPower, dualOffset);
+}
+
+Flower *Flower::outerFlower()
+{
+	Flower *outerFlower(this);
+	while (outerFlower->enclosingFlower != nullptr) {
+		outerFlower = outerFlower->enclosingFlower;
 	}
-	return currentFlower;
+	return outerFlower;
 }
 
-Edge *Flower::inPairingEdge()
+bool Flower::contains(const Flower *flower) const
 {
-	STD_VECTOR_FOREACH_(Edge *, this->edges, edgeIt, edgeEnd) {
-		Edge *edge(*edgeIt);
-		if (edge->type == Edge::Type::FULL_IN_PAIRING) {
-			return edge;
-		}
+	// The heights grow along the enclosing flowers, so the walk can stop at the height of this flower.
+	while ((flower != nullptr) && (flower->nestingHeight < this->nestingHeight)) {
+		flower = flower->enclosingFlower;
 	}
+	return flower == this;
+}
 
+Flower *Flower::nextBlueFlower(const Flower *blueFlower) const
+{
+	return (blueFlower == this->lastBlueFlower) ? nullptr : blueFlower->followingBlueFlower;
+}
+
+Flower *Flower::subFlowerContaining(Flower *flower) const
+{
+	while ((flower != nullptr) && (flower->enclosingFlower != this) && (flower->nestingHeight < this->nestingHeight)) {
+		flower = flower->enclosingFlower;
+	}
+	return ((flower != nullptr) && (flower->enclosingFlower == this)) ? flower : nullptr;
+}
+
+Edge *Flower::cycleEdge(const Flower *subFlowerA, const Flower *subFlowerB) const
+{
+	int subFlowerCount(static_cast<int>(this->subFlowers.size()));
+	return ((subFlowerA->cycleIndex + 1) % subFlowerCount == subFlowerB->cycleIndex)
+		? this->cycleEdges[subFlowerA->cycleIndex] : this->cycleEdges[subFlowerB->cycleIndex];
+}
+
+Edge *Flower::inPairingEdge(const std::vector<Flower *> &flowers)
+{
 #ifdef ENABLE_DEBUG_ASSERTIONS
+	// ASSERTION: The kept edge is the in pairing edge found by a scan of the edges of the blue flowers.
+	Edge *scannedEdge(nullptr);
+	for (Flower *blueFlower(this->firstBlueFlower); blueFlower != nullptr; blueFlower = this->nextBlueFlower(blueFlower)) {
+		RANGE_FOREACH_(EdgeRange, blueFlower->edges, edgeIt, edgeEnd) {
+			Edge *edge(*edgeIt);
+			if ((edge->type == Edge::Type::FULL_IN_PAIRING) && !this->contains(edge->oppositeBlueFlower(blueFlower, flowers))) {
+				scannedEdge = edge;
+			}
+		}
+	}
+	if (scannedEdge != this->pairingEdge) {
+		std::cout << "Assertion failed: The kept in pairing edge differs from the scanned one." << std::endl;
+		std::exit(-1);
+	}
+
 	// ASSERTION: This method should not be called in a case where the desired edge does not exist.
-	std::cout << "Assertion failed: inPairingEdge method called when no such edge exists." << std::endl;
-	std::exit(-1);
+	if (this->pairingEdge == nullptr) {
+		std::cout << "Assertion failed: inPairingEdge method called when no such edge exists." << std::endl;
+		std::exit(-1);
+	}
+#else
+	(void)flowers;
 #endif
 
-	return nullptr;
+	return this->pairingEdge;
 }
 
-std::vector<Flower *> Flower::blueSubFlowers()
+void Flower::setPairingEdge(Edge *pairingEdge)
 {
-	std::vector<Flower *> result;
-	STD_VECTOR_FOREACH_(Flower *, this->subFlowers, flowerIt, flowerEnd) {
-		Flower *flower(*flowerIt);
-		if (flower->isGreen()) {
-			std::vector<Flower *> subResult(flower->blueSubFlowers());
-			result.insert(result.end(), subResult.begin(), subResult.end());
-		} else {
-			result.push_back(flower);
-		}
+	for (Flower *stemFlower(this); stemFlower != nullptr; stemFlower = stemFlower->stemSubFlower) {
+		stemFlower->pairingEdge = pairingEdge;
+	}
+}
+
+void Flower::blueSubFlowers(std::vector<Flower *> &blueSubFlowers)
+{
+	for (Flower *blueFlower(this->firstBlueFlower); blueFlower != nullptr; blueFlower = this->nextBlueFlower(blueFlower)) {
+		blueSubFlowers.push_back(blueFlower);
 	}
-	return result;
 }
 
 Flower *Flower::blueStem()
@@ -84,20 +203,57 @@ bool Edge::isFull() const
 	return this->type != Type::REGULAR;
 }
 
+bool Edge::crosses(const Flower *flower, const std::vector<Flower *> &flowers) const
+{
+	return flower->contains(this->blueFlower(0, flowers)) != flower->contains(this->blueFlower(1, flowers));
+}
+
+Weight Edge::crossedPower(const std::vector<Flower *> &flowers, Weight dualOffset, int &incrementableFlowerCount) const
+{
+	Weight power(0);
+	incrementableFlowerCount = 0;
+
+	// A loop counts the power of its blue flower twice.
+	const Flower *flowerA(this->blueFlower(0, flowers));
+	const Flower *flowerB(this->blueFlower(1, flowers));
+	if (flowerA == flowerB) {
+		power = 2 * flowerA->power(dualOffset);
+		incrementableFlowerCount = 2 * dualOffsetFactor(flowerA->type);
+		return power;
+	}
+
+	// The lower walk steps first, so the walks meet in the smallest flower containing both blue flowers,
+	// or both leave their free flowers.
+	while (flowerA != flowerB) {
+		bool isLowerA((flowerB == nullptr) || ((flowerA != nullptr) && (flowerA->nestingHeight <= flowerB->nestingHeight)));
+		const Flower *&crossedFlower(isLowerA ? flowerA : flowerB);
+
+		power += crossedFlower->power(dualOffset);
+		incrementableFlowerCount += dualOffsetFactor(crossedFlower->type);
+
+		crossedFlower = crossedFlower->enclosingFlower;
+	}
+
+	return power;
+}
+
 Edge::Edge()
-: type(Type::REGULAR)
-, weight(0.0)
-{}
+: weight(0)
+, queuePosition(-1)
+, type(Type::REGULAR)
+, isRemoved(false)
+{
+	for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+		this->blueFlowerIndices[i] = -1;
+	}
+}
 
-std::vector<Flower *> Edge::freeFlowers()
+std::vector<Flower *> Edge::freeFlowers(const std::vector<Flower *> &flowers) const
 {
 	std::vector<Flower *> result;
 
-	STD_VECTOR_FOREACH_(Flower *, this->flowers, flowerIt, flowerEnd) {
-		Flower *flower(*flowerIt);
-		if (flower->isFree()) {
-			result.push_back(flower);
-		}
+	for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+		result.push_back(this->blueFlower(i, flowers)->outerFlower());
 	}
 
 #ifdef ENABLE_DEBUG_ASSERTIONS
@@ -1,6 +1,7 @@
 #ifndef EDMONDS_ALGORITHM_TYPES_H
 #define EDMONDS_ALGORITHM_TYPES_H
 
+#include "Pool.h"
 #include "Utility.h"
 
 #include <vector>
@@ -8,6 +9,42 @@
 class Edge;
 class Flower;
 
+// View of a contiguous array of edge indices owned elsewhere, which gives the edges of the pool for the indices.
+// Indices take half the memory of pointers, and the adjacency of every vertex is such an array.
+class EdgeRange
+{
+public:
+	class iterator
+	{
+	public:
+		iterator(const int *edgeIndex, const IndexedPool<Edge> *edgePool);
+
+		Edge *operator*() const;
+		iterator &operator++();
+		bool operator!=(const iterator &other) const;
+
+	private:
+		const int *edgeIndex;
+		const IndexedPool<Edge> *edgePool;
+	};
+
+	EdgeRange();
+	EdgeRange(const int *first, const int *last, const IndexedPool<Edge> *edgePool);
+
+	iterator begin() const;
+	iterator end() const;
+
+	bool empty() const;
+
+	const int *firstIndex() const;
+	const int *lastIndex() const;
+
+private:
+	const int *first;
+	const int *last;
+	const IndexedPool<Edge> *edgePool;
+};
+
 class Flower
 {
 public:
@@ -20,31 +57,105 @@ public:
 	};
 
 	Type type;
-	double power;
+
+	// Power of the flower stored relative to the dual offset, which is the sum of all applied epsilon values.
+	// Tree flowers follow the dual offset without being touched, see power().
+	Weight stampedPower;
 
 	std::vector<Flower *> subFlowers;
 	Flower *stemSubFlower;
 
+	// Edges of the cycle of a green flower, where the edge at each index joins the subflower at that index with the next one.
+	std::vector<Edge *> cycleEdges;
+
+	// Index of this flower among the subflowers of the green flower that was created around it.
+	int cycleIndex;
+
 	Flower *parent;
 	std::vector<Flower *> children;
 
-	std::vector<Edge *> edges;
+	// The full edge between a tree flower and its parent, or null if the flower has no parent.
+	Edge *parentEdge;
+
+	// The in pairing edge crossing this flower, or null if the flower is exposed.
+	// The edge crosses the stem subflower as well, so it is shared by the whole chain of stem subflowers.
+	Edge *pairingEdge;
+
+	// The green flower whose cycle contains this flower, or null if the flower is free.
+	Flower *enclosingFlower;
+
+	// Number of nested green flowers on the longest path from this flower down to a blue flower, zero for blue flowers.
+	// Unlike a depth it stays the same when the flower is enclosed or its enclosing flower is burst,
+	// and it grows along every chain of enclosing flowers.
+	int nestingHeight;
+
+	// The blue flowers within a flower form a contiguous run, which starts at the first and ends at the last blue flower.
+	// Creating a flower only links the runs of its subflowers, see nextBlueFlower().
+	Flower *firstBlueFlower;
+	Flower *lastBlueFlower;
+	Flower *followingBlueFlower;
+
+	// Identifies the tree containing this free flower, or is negative if the flower is in a dumbbell.
+	int treeId;
+
+	// Blue flowers view their slice of the adjacency array built after the input is read,
+	// until an edge is added or removed after a solve, which gives them their own outgoing edges.
+	// Green flowers store no edges, their outgoing edges are the edges of their blue flowers that cross them.
+	EdgeRange edges;
+	std::vector<int> outgoingEdges;
 
 	int vertexId;
 
+	int queuePosition;
+
+	// The free flower containing this flower and the sum of the powers of the flowers from this one up to it,
+	// which are only valid during the refresh of the event queue with the same stamp, see EventQueue::refreshTouchedFlowers.
+	int chainStamp;
+	Flower *chainOuterFlower;
+	Weight chainPower;
+
 	Flower();
 
 	bool isInDumbbell() const;
 	bool isFree() const;
 	bool isGreen() const;
 
-	Flower *root();
-	Edge *inPairingEdge();
+	Weight power(Weight dualOffset) const;
+	void setPower(Weight power, Weight dualOffset);
+
+	// Changes the type of the flower while keeping its power.
+	void setType(Type type, Weight dualOffset);
+
+	// Returns the free flower containing this flower, or the flower itself if it is free.
+	// It is found by walking up the enclosing flowers, so that nesting a flower never relabels its subflowers.
+	Flower *outerFlower();
 
-	std::vector<Flower *> blueSubFlowers();
+	// Returns whether the given flower lies within this flower or is this flower.
+	bool contains(const Flower *flower) const;
+
+	// Returns the blue flower following the given one in the run of this flower, or null after the last one.
+	Flower *nextBlueFlower(const Flower *blueFlower) const;
+
+	// Returns the subflower of this flower that contains the given flower, or null if the flower lies outside.
+	Flower *subFlowerContaining(Flower *flower) const;
+
+	// Returns the edge of the cycle of this flower between two neighbouring subflowers.
+	Edge *cycleEdge(const Flower *subFlowerA, const Flower *subFlowerB) const;
+
+	// Returns the kept in pairing edge, which a scan of the edges of the blue flowers among the flowers confirms in debug builds.
+	Edge *inPairingEdge(const std::vector<Flower *> &flowers);
+
+	// Sets the in pairing edge of this flower and of its chain of stem subflowers.
+	void setPairingEdge(Edge *pairingEdge);
+
+	// Appends the blue flowers within this flower in cycle order.
+	void blueSubFlowers(std::vector<Flower *> &blueSubFlowers);
 	Flower *blueStem();
 };
 
+// Determines how the power of a flower of the given type follows the dual offset.
+int dualOffsetFactor(Flower::Type type);
+
 class Edge
 {
 public:
@@ -57,15 +168,70 @@ public:
 
 	Edge();
 
+	// The members are ordered by size, so that an edge takes 24 bytes.
+	Weight weight;
+
+	// Indices of the blue flowers among the flowers of the solver, which are the indices of their vertices.
+	// Indices take half the memory of pointers, just as in the adjacency of every vertex.
+	int blueFlowerIndices[VERTEX_PER_EDGE_COUNT];
+
+	int queuePosition;
+
 	Type type;
-	double weight;
 
-	std::vector<Flower *> flowers;
-	std::vector<Flower *> blueFlowers;
+	// Removed edges keep their place among the edges, but are never queued.
+	bool isRemoved;
 
 	bool isFull() const;
 
-	std::vector<Flower *> freeFlowers();
+	// Returns the blue flower at the given end of the edge, looked up among the flowers of the solver.
+	Flower *blueFlower(int end, const std::vector<Flower *> &flowers) const;
+
+	// Returns whether exactly one blue flower of the edge lies within the flower.
+	bool crosses(const Flower *flower, const std::vector<Flower *> &flowers) const;
+
+	// Returns the blue flower at the other end of the edge.
+	Flower *oppositeBlueFlower(const Flower *blueFlower, const std::vector<Flower *> &flowers) const;
+
+	// Returns the sum of the powers of the flowers crossed by the edge and counts its incrementable flowers.
+	// The crossed flowers are found by walking up from both blue flowers, until both walks meet in a common flower.
+	Weight crossedPower(const std::vector<Flower *> &flowers, Weight dualOffset, int &incrementableFlowerCount) const;
+
+	std::vector<Flower *> freeFlowers(const std::vector<Flower *> &flowers) const;
 };
 
+// The iterator and the lookup of blue flowers are defined inline, as they run in the innermost loops over the edges.
+
+inline EdgeRange::iterator::iterator(const int *edgeIndex, const IndexedPool<Edge> *edgePool)
+: edgeIndex(edgeIndex)
+, edgePool(edgePool)
+{}
+
+inline Edge *EdgeRange::iterator::operator*() const
+{
+	return this->edgePool->at(*this->edgeIndex);
+}
+
+inline EdgeRange::iterator &EdgeRange::iterator::operator++()
+{
+	++this->edgeIndex;
+	return *this;
+}
+
+inline bool EdgeRange::iterator::operator!=(const iterator &other) const
+{
+	return this->edgeIndex != other.edgeIndex;
+}
+
+inline Flower *Edge::blueFlower(int end, const std::vector<Flower *> &flowers) const
+{
+	return flowers[this->blueFlowerIndices[end]];
+}
+
+inline Flower *Edge::oppositeBlueFlower(const Flower *blueFlower, const std::vector<Flower *> &flowers) const
+{
+	// The vertex of a blue flower is one past its index, and the indices of a loop are equal.
+	return flowers[this->blueFlowerIndices[0] + this->blueFlowerIndices[1] - (blueFlower->vertexId - 1)];
+}
+
 #endif // EDMONDS_ALGORITHM_TYPES_H
\ No newline at end of file
@@ -2,10 +2,20 @@
 #define EDMONDS_ALGORITHM_UTILITY_H
 
 #ifdef _DEBUG
-#define ENABLE_DEBUG_CHOSEN_ACTION
-#define ENABLE_DEBUG_GRAPH_STATE
 #define ENABLE_DEBUG_ASSERTIONS
-#define ENABLE_DEBUG_VERBOUS_OUTPUT
+#endif
+
+// Stores weights and powers as integers, so that every comparison of paddings is exact.
+// The input weights must be integers and are scaled by WEIGHT_SCALE,
+// so that halving the padding of an edge between two even flowers never leaves a remainder.
+// #define ENABLE_INTEGER_WEIGHTS
+
+#ifdef ENABLE_INTEGER_WEIGHTS
+typedef long long Weight;
+#define WEIGHT_SCALE 2
+#else
+typedef double Weight;
+#define WEIGHT_SCALE 1
 #endif
 
 #define VERTEX_PER_EDGE_COUNT 2
@@ -16,5 +26,7 @@
 	for (std::vector<t>::iterator it(v.begin()), endIt(v.end()); it != endIt; ++it)
 #define STD_VECTOR_CONST_FOREACH_(t,v,it,endIt) \
 	for (std::vector<t>::const_iterator it(v.cbegin()), endIt(v.cend()); it != endIt; ++it)
+#define RANGE_FOREACH_(t,r,it,endIt) \
+	for (t::iterator it(r.begin()), endIt(r.end()); it != endIt; ++it)
 
 #endif // EDMONDS_ALGORITHM_UTILITY_H
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "WarmStart.h"
+
+#include "Types.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#if VERTEX_PER_EDGE_COUNT != 2
+CREATE A COMPILATION ERROR
+#endif
+
+// Rounds a power down, so that with scaled integer weights the padding of an edge between two even flowers stays even.
+Weight roundPower(Weight power)
+{
+#ifdef ENABLE_INTEGER_WEIGHTS
+	return power - (((power % 2) + 2) % 2);
+#else
+	return power;
+#endif
+}
+
+// Returns the padding of an edge between blue flowers, while no dual offset has been applied yet.
+Weight blueEdgePadding(const Edge *edge, const std::vector<Flower *> &flowers)
+{
+	return edge->weight - edge->blueFlower(0, flowers)->power(0) - edge->blueFlower(1, flowers)->power(0);
+}
+
+// Pairs a blue flower with the other one of the edge, making both dumbbells.
+void pairBlueFlowers(Edge *edge, const std::vector<Flower *> &flowers)
+{
+	edge->type = Edge::Type::FULL_IN_PAIRING;
+	for (int i(0); i < VERTEX_PER_EDGE_COUNT; ++i) {
+		Flower *blueFlower(edge->blueFlower(i, flowers));
+		blueFlower->setType(Flower::Type::IN_DUMBBELL, 0);
+		blueFlower->treeId = -1;
+		blueFlower->pairingEdge = edge;
+	}
+}
+
+// Looks for a path of three full edges from the unpaired flower through a dumbbell to another unpaired flower,
+// and swaps the pairing along it. Returns whether the pairing was extended.
+bool augmentThroughDumbbell(Flower *flower, const std::vector<Flower *> &flowers)
+{
+	RANGE_FOREACH_(EdgeRange, flower->edges, edgeIt, edgeEnd) {
+		Edge *firstEdge(*edgeIt);
+		Flower *upperFlower(firstEdge->oppositeBlueFlower(flower, flowers));
+		if ((upperFlower == flower) || !upperFlower->isInDumbbell() || (blueEdgePadding(firstEdge, flowers) != 0)) {
+			continue;
+		}
+
+		Edge *dumbbellEdge(upperFlower->inPairingEdge(flowers));
+		Flower *lowerFlower(dumbbellEdge->oppositeBlueFlower(upperFlower, flowers));
+		RANGE_FOREACH_(EdgeRange, lowerFlower->edges, lowerEdgeIt, lowerEdgeEnd) {
+			Edge *lastEdge(*lowerEdgeIt);
+			Flower *endFlower(lastEdge->oppositeBlueFlower(lowerFlower, flowers));
+			bool isAugmenting((endFlower != flower) && (endFlower != lowerFlower) && !endFlower->isInDumbbell()
+				&& (blueEdgePadding(lastEdge, flowers) == 0));
+			if (isAugmenting) {
+				dumbbellEdge->type = Edge::Type::REGULAR;
+				pairBlueFlowers(firstEdge, flowers);
+				pairBlueFlowers(lastEdge, flowers);
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+int executeWarmStart(const std::vector<Flower *> &flowers)
+{
+	// Give each flower half the weight of its lightest edge, so that no edge is overfull.
+	STD_VECTOR_CONST_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
+		Flower *flower(*flowerIt);
+		if (flower->edges.empty()) {
+			continue;
+		}
+
+		Weight minWeight(std::numeric_limits<Weight>::max());
+		RANGE_FOREACH_(EdgeRange, flower->edges, edgeIt, edgeEnd) {
+			minWeight = std::min(minWeight, (*edgeIt)->weight);
+		}
+		flower->setPower(roundPower(minWeight / 2), 0);
+	}
+
+	// Raise the power of each unpaired flower until one of its edges is full, and pair it along a full edge
+	// with another unpaired flower if there is one.
+	int pairingEdgeCount(0);
+	STD_VECTOR_CONST_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
+		Flower *flower(*flowerIt);
+		if (flower->isInDumbbell() || flower->edges.empty()) {
+			continue;
+		}
+
+		// A loop counts the power of the flower twice.
+		// Among the edges that become full, prefer one leading to an unpaired flower.
+		Weight maxIncrement(std::numeric_limits<Weight>::max());
+		Edge *pairingEdge(nullptr);
+		RANGE_FOREACH_(EdgeRange, flower->edges, edgeIt, edgeEnd) {
+			Edge *edge(*edgeIt);
+			Flower *oppositeFlower(edge->oppositeBlueFlower(flower, flowers));
+			Weight weightPadding(blueEdgePadding(edge, flowers));
+			if (oppositeFlower == flower) {
+				weightPadding /= 2;
+			}
+
+			bool isPairable((oppositeFlower != flower) && !oppositeFlower->isInDumbbell());
+			if (weightPadding < maxIncrement) {
+				maxIncrement = weightPadding;
+				pairingEdge = isPairable ? edge : nullptr;
+			} else if ((weightPadding == maxIncrement) && (pairingEdge == nullptr) && isPairable) {
+				pairingEdge = edge;
+			}
+		}
+
+		// With integer weights an odd padding cannot be filled completely.
+		Weight increment(roundPower(maxIncrement));
+		flower->setPower(flower->power(0) + increment, 0);
+		if ((pairingEdge == nullptr) || (increment != maxIncrement)) {
+			continue;
+		}
+
+		pairBlueFlowers(pairingEdge, flowers);
+		++pairingEdgeCount;
+	}
+
+	// Improve the pairing locally, without changing any power.
+	STD_VECTOR_CONST_FOREACH_(Flower *, flowers, flowerIt, flowerEnd) {
+		Flower *flower(*flowerIt);
+		if (!flower->isInDumbbell() && augmentThroughDumbbell(flower, flowers)) {
+			++pairingEdgeCount;
+		}
+	}
+
+	return pairingEdgeCount;
+}
\ No newline at end of file
@@ -0,0 +1,15 @@
+#ifndef EDMONDS_ALGORITHM_WARM_START_H
+#define EDMONDS_ALGORITHM_WARM_START_H
+
+#include "Types.h"
+
+#include <vector>
+
+// Builds a greedy pairing of blue flowers together with powers that keep every edge feasible,
+// so that the core algorithm loop starts with fewer trees.
+// Paired flowers become dumbbells, the others remain roots of their trees.
+// Must be called on blue flowers with their edges set, before the edges are queued.
+// Returns the number of edges added to the pairing.
+int executeWarmStart(const std::vector<Flower *> &flowers);
+
+#endif // EDMONDS_ALGORITHM_WARM_START_H
\ No newline at end of file